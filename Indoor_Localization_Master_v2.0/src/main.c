@@ -7,6 +7,11 @@
 #include <drivers/hwinfo.h>
 #include <stdlib.h>
 #include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <localization.h>
+#include <wire.h>
 
 #define DEFAULT_RADIO_NODE DT_ALIAS(lora0)
 BUILD_ASSERT(DT_NODE_HAS_STATUS(DEFAULT_RADIO_NODE, okay),
@@ -49,50 +54,63 @@ raspi17     d2 bf 5c 98
 #define ALIVE 0x08
 #define ALIVE_ACK 0x09
 #define ALL_DONE_PKT 0x06
-#define ANCHOR_PKT 0x10
-#define CORNER_PKT 0x12
 #define NONE 0xFF
 //
 
 LOG_MODULE_REGISTER(Indoor_Localization_Master);
 
-struct __attribute__((__packed__)) Coordinates
-{
-    bool flag; //  Validated Coordinates if TRUE else not validated
-    float x;
-    float y;
-};
-
 /*
 ************ Payload Format ************
 DEVICE_ID | OPERATION | DEVICE_COORDINATES
+
+A RANGING_INIT may append the MAP_ID of the anchor map the mobile has cached.
 */
 
 struct __attribute__((__packed__)) Payload
 {
     uint32_t host_id;
     uint8_t operation;
-    struct Coordinates coords;
+    union
+    {
+        struct __attribute__((__packed__))
+        {
+            struct Coordinates coords;
+            uint32_t map_id;
+        };
+        uint8_t data[MAX_DATA_LEN - 5]; // Whole received packet fits
+    };
 };
 
-const uint32_t anchor_id[MAX_ANCHORS] = {RASPI03, RASPI06, RASPI07, RASPI10, RASPI12, RASPI16, RASPI17};
+#define RANGING_INIT_MAP_LEN (offsetof(struct Payload, map_id) + sizeof(uint32_t))
+BUILD_ASSERT(sizeof(struct Payload) == MAX_DATA_LEN, "Payload must hold a whole received packet");
 
-struct Anchor
-{
-    uint32_t host_id;
-    struct Coordinates coords;
-};
+/*
+************ Anchor Table ************
+The anchor map goes out as ANCHOR_TABLE_PKT frames (see wire.h): the building
+outline, every anchor with its mounting height Z and range calibration, and
+the done marker, packed into as few frames as fit.
+
+Z is the mounting height above the floor in map pixels, used by the mobile in
+its 2.5D and 3D modes. The building outline is a simple polygon in map pixels,
+in either winding order, of at most LOC_MAX_VERTICES vertices.
+
+The table is sent in the compact encoding: whole map pixels as int16 and
+quantized calibration. WIRE_VERSION_FLOAT keeps full float precision for maps
+beyond the int16 pixel range; the mobile accepts both.
+*/
 
-struct Coordinates bottom_left_corner = {
-    .flag = false,
-    .x = 0.0,
-    .y = 0.0,
-};
-struct Coordinates top_right_corner = {
-    .flag = true,
-    .x = 2865,
-    .y = 2865,
-};
+#define ANCHOR_TABLE_VERSION WIRE_VERSION_COMPACT
+
+#define ANCHOR_HEIGHT 0.0f // Common mounting height of the anchors in map pixels
+
+#define BUILDING_VERTICES 4
+
+const float building_x[BUILDING_VERTICES] = {0, 2865, 2865, 0};
+const float building_y[BUILDING_VERTICES] = {0, 0, 2865, 2865};
+
+BUILD_ASSERT(BUILDING_VERTICES >= 3 && BUILDING_VERTICES <= LOC_MAX_VERTICES, "Building outline too large");
+
+const uint32_t anchor_id[MAX_ANCHORS] = {RASPI03, RASPI06, RASPI07, RASPI10, RASPI12, RASPI16, RASPI17};
 
 void get_anchor_coordinates(uint32_t host_id, struct Coordinates *coords)
 {
@@ -140,6 +158,110 @@ void get_anchor_coordinates(uint32_t host_id, struct Coordinates *coords)
     }
 }
 
+float get_anchor_height(uint32_t host_id)
+{
+    switch (host_id)
+    {
+    default:
+        return ANCHOR_HEIGHT;
+    }
+}
+
+/*
+Measured range correction of an anchor. Returns false for anchors that have
+none, their ranges are used as measured.
+*/
+bool get_anchor_calibration(uint32_t host_id, struct Range_Calibration *calib)
+{
+    switch (host_id)
+    {
+    /*
+    case RASPI12:
+        calib->offset = -35.0;
+        calib->scale = 1.0;
+        calib->rssi_slope = 0.0;
+        calib->rssi_ref = -80;
+        return true;
+    */
+    default:
+        return false;
+    }
+}
+
+uint32_t map_id; // Set by the first send_anchor_table()
+
+/*
+Sends the frame, if lora_dev is set, and starts the next one of the table.
+*/
+static void flush_frame(const struct device *lora_dev, struct Wire_Frame *frame)
+{
+    if (lora_dev != NULL)
+    {
+        k_sleep(K_MSEC(20));
+        lora_send(lora_dev, frame->buf, frame->len);
+        k_sleep(K_MSEC(30));
+    }
+    wire_frame_next(frame);
+}
+
+/*
+Sends the building outline, the anchors and their calibration to the mobile
+host_id, then the map id and the done marker. A record that does not fit goes
+first in the next frame. With lora_dev NULL the table is only encoded, to get
+its map_id. Returns the number of frames.
+*/
+int send_anchor_table(const struct device *lora_dev, uint32_t host_id)
+{
+    static struct Wire_Frame frame;
+    struct Range_Calibration calib;
+    struct Coordinates coords;
+    int frames = 1;
+    int i;
+
+    wire_frame_begin(&frame, host_id, ANCHOR_TABLE_VERSION);
+    wire_put_outline(&frame, building_x, building_y, BUILDING_VERTICES);
+    for (i = 0; i < MAX_ANCHORS; i++)
+    {
+        get_anchor_coordinates(anchor_id[i], &coords);
+        if (!wire_put_anchor(&frame, anchor_id[i], coords, get_anchor_height(anchor_id[i])))
+        {
+            flush_frame(lora_dev, &frame);
+            frames++;
+            wire_put_anchor(&frame, anchor_id[i], coords, get_anchor_height(anchor_id[i]));
+        }
+        if (get_anchor_calibration(anchor_id[i], &calib) && !wire_put_calib(&frame, anchor_id[i], &calib))
+        {
+            flush_frame(lora_dev, &frame);
+            frames++;
+            wire_put_calib(&frame, anchor_id[i], &calib);
+        }
+    }
+    if (frame.len + WIRE_MAP_ID_SIZE + WIRE_DONE_SIZE > WIRE_FRAME_SIZE)
+    {
+        flush_frame(lora_dev, &frame);
+        frames++;
+    }
+    map_id = wire_table_hash(&frame);
+    wire_put_map_id(&frame, map_id);
+    wire_put_done(&frame);
+    flush_frame(lora_dev, &frame);
+    return frames;
+}
+
+/*
+Tells the mobile host_id that the map it cached is still current: a table of
+only the map id and the done marker.
+*/
+void send_map_current(const struct device *lora_dev, uint32_t host_id)
+{
+    static struct Wire_Frame frame;
+
+    wire_frame_begin(&frame, host_id, ANCHOR_TABLE_VERSION);
+    wire_put_map_id(&frame, map_id);
+    wire_put_done(&frame);
+    flush_frame(lora_dev, &frame);
+}
+
 /*
 void get_host_coordinates(uint32_t host_id, struct Coordinates *coords)
 {
@@ -200,6 +322,7 @@ void main(void)
     int16_t rssi;
     int8_t snr;
     bool ranging_req_possible = true;
+    bool map_cached = false;
     int count = 0;
     uint32_t ranging_req_id = 0x0000;
     uint8_t operation = RECEIVE;
@@ -233,6 +356,11 @@ void main(void)
         return;
     }
 
+    // Encode the table once for its map id.
+    count = send_anchor_table(NULL, 0);
+    LOG_INF("Anchor map %08x, %d frame(s).", map_id, count);
+    count = 0;
+
     while (1)
     {
 
@@ -240,7 +368,7 @@ void main(void)
         {
         case RECEIVE:
             LOG_INF("RECEIVE MODE.");
-            len = lora_recv(lora_dev, payload_ptr, MAX_DATA_LEN, K_MSEC(5000),
+            len = lora_recv(lora_dev, payload_ptr, sizeof(payload), K_MSEC(5000),
                             &rssi, &snr);
             // LOG_INF("LEN : %d", len);
             if (len < 0)
@@ -258,72 +386,31 @@ void main(void)
                 k_sleep(K_MSEC(30));
                 LOG_INF("RANGING POSSIBLE");
                 ranging_req_id = payload.host_id;
+                map_cached = len >= (int)RANGING_INIT_MAP_LEN && payload.map_id == map_id;
                 count = 0;
-                operation = CORNER_PKT;
+                operation = ANCHOR_TABLE_PKT;
                 ranging_req_possible = false;
                 break;
             }
             operation = RECEIVE;
             break;
 
-        case CORNER_PKT:
-            LOG_INF("SENDING BUILDING CORNERS.");
-            if (count < 1)
+        case ANCHOR_TABLE_PKT:
+            if (map_cached)
             {
-                payload.host_id = ranging_req_id;
-                payload.coords = bottom_left_corner;
-                payload.operation = CORNER_PKT;
-
-                k_sleep(K_MSEC(20));
-                ret = lora_send(lora_dev, payload_ptr, sizeof(payload));
-                k_sleep(K_MSEC(30));
-
-                operation = CORNER_PKT;
-                count++;
+                LOG_INF("ANCHOR MAP %08x CACHED BY MOBILE.", map_id);
+                send_map_current(lora_dev, ranging_req_id);
             }
             else
             {
-                payload.host_id = ranging_req_id;
-                payload.coords = top_right_corner;
-                payload.operation = CORNER_PKT;
-
-                k_sleep(K_MSEC(20));
-                ret = lora_send(lora_dev, payload_ptr, sizeof(payload));
-                k_sleep(K_MSEC(30));
-
+                LOG_INF("SENDING ANCHOR TABLE.");
+                count = send_anchor_table(lora_dev, ranging_req_id);
+                LOG_INF("Anchor table sent in %d frame(s).", count);
                 count = 0;
-                operation = ANCHOR_PKT;
             }
-            break;
-
-        case ANCHOR_PKT:
-            if (count == MAX_ANCHORS)
-            {
-                payload.operation = ALL_DONE_PKT;
-                payload.host_id = ranging_req_id;
-                payload.coords = dev_coords;
-
-                k_sleep(K_MSEC(20));
-                ret = lora_send(lora_dev, payload_ptr, sizeof(payload));
-                k_sleep(K_MSEC(30));
 
-                count = 0;
-
-                ranging_req_possible = true;
-                operation = RECEIVE;
-                break;
-            }
-
-            payload.host_id = anchor_id[count];
-            payload.operation = ANCHOR_PKT;
-            get_anchor_coordinates(anchor_id[count], &payload.coords);
-
-            k_sleep(K_MSEC(20));
-            ret = lora_send(lora_dev, payload_ptr, sizeof(payload));
-            k_sleep(K_MSEC(30));
-            operation = ANCHOR_PKT;
-
-            count++;
+            ranging_req_possible = true;
+            operation = RECEIVE;
             break;
         /*
         case START_RANGING:
@@ -7,8 +7,21 @@
 #include <zephyr.h>
 #include <logging/log.h>
 #include <drivers/hwinfo.h>
-#include <stdlib.h>
 #include <math.h>
+#include <stddef.h>
+
+#include <localization.h>
+#include <round_ring.h>
+#include <wire.h>
+#include <trace.h>
+
+#if defined(CONFIG_LOCALIZATION_SOLVER_TIMING)
+#include <timing/timing.h>
+#endif
+
+#if defined(CONFIG_LOCALIZATION_MAP_CACHE)
+#include <settings/settings.h>
+#endif
 
 #define DEFAULT_RADIO_NODE DT_ALIAS(lora0)
 BUILD_ASSERT(DT_NODE_HAS_STATUS(DEFAULT_RADIO_NODE, okay),
@@ -32,6 +45,8 @@ BUILD_ASSERT(DT_NODE_HAS_STATUS(DEFAULT_RADIO_NODE, okay),
 #define ANCHOR_PKT 0x10
 #define RE_RANGING_PKT 0x11
 #define CORNER_PKT 0x12
+#define CALIB_PKT 0x13
+#define BUILDING_PKT 0x14
 #define NONE 0xFF
 //
 
@@ -41,133 +56,60 @@ const uint16_t TxtimeoutmS = 5000;
 const uint16_t RxtimeoutmS = 0xFFFF;
 const uint32_t device_address = 01;
 
-struct __attribute__((__packed__)) Coordinates
-{
-    bool flag; //  Validated Coordinates if TRUE else not validated
-    float x;
-    float y;
-};
-
 /*
 ************ Payload Format ************
 DEVICE_ID | OPERATION | DATA_POINTER
-*/
 
-struct __attribute__((__packed__)) Payload
-{
-    uint32_t host_id;
-    uint8_t operation;
-    struct Coordinates coords;
-};
+ANCHOR_PKT may append the mounting height Z (map pixels) to the coordinates,
+anchors sent without it are taken to be at the floor. CALIB_PKT carries the
+range calibration of anchor DEVICE_ID in place of the coordinates.
+BUILDING_PKT carries the building outline, COUNT | COUNT x [X | Y], in a single
+packet; it replaces the two CORNER_PKTs, which are still accepted.
 
-struct Anchor
-{
-    uint32_t host_id;
-    struct Coordinates coords;
-    float distance;
-    int16_t RSSI;
-    struct Anchor *next;
-};
-
-struct Coordinates bottom_left_corner = {
-    .flag = false,
-    .x = -1,
-    .y = -1,
-};
-struct Coordinates top_right_corner = {
-    .flag = false,
-    .x = -1,
-    .y = -1,
-};
-
-/* ********* Queue Operations ********** */
-
-struct Anchor *front = NULL;
-struct Anchor *rear = NULL;
-int anchor_count = 0;
+The master now sends the whole map as ANCHOR_TABLE_PKT frames (see wire.h),
+read straight from the receive buffer; the single-record packets above are
+still understood. RANGING_INIT appends the MAP_ID of the cached map, if any.
+*/
 
-bool already_existing(uint32_t host_id)
+struct __attribute__((__packed__)) Building_Vertex
 {
-    struct Anchor *temp_anchor;
-    temp_anchor = front;
-    do
-    {
-        if (temp_anchor->host_id == host_id)
-        {
-            return true;
-        }
-        temp_anchor = temp_anchor->next;
-    } while (temp_anchor != NULL);
-    return false;
-}
+    float x;
+    float y;
+};
 
-bool add_anchor(uint32_t host_id, struct Coordinates coords)
-{
-    struct Anchor *n_anchor = malloc(sizeof(struct Anchor));
-    n_anchor->coords = coords;
-    n_anchor->host_id = host_id;
-    n_anchor->distance = -1;
-    // n_anchor->re_distance = -1;
-    n_anchor->RSSI = 0;
-    // n_anchor->re_RSSI = 0;
-    n_anchor->next = NULL;
-
-    if (rear == NULL)
-    {
-        front = n_anchor;
-        rear = n_anchor;
-    }
-    else
-    {
-        if (already_existing(n_anchor->host_id))
-            return false;
-        rear->next = n_anchor;
-        rear = rear->next;
-    }
-    anchor_count++;
-    return true;
-}
+#define BUILDING_PKT_VERTICES ((MAX_DATA_LEN - 6) / sizeof(struct Building_Vertex))
 
-void remove_anchor(struct Anchor *prev_anchor, struct Anchor *anchor_ptr)
+struct __attribute__((__packed__)) Payload
 {
-    if (prev_anchor == NULL)
-    {
-        front = anchor_ptr->next;
-    }
-    else
+    uint32_t host_id;
+    uint8_t operation;
+    union
     {
-        if (anchor_ptr->next == NULL)
+        struct __attribute__((__packed__))
         {
-            if (prev_anchor == NULL)
-                rear = NULL;
-            else
-                rear = prev_anchor;
-        }
-        else
+            struct Coordinates coords;
+            union
+            {
+                float z;
+                uint32_t map_id;
+            };
+        };
+        struct Range_Calibration calib;
+        struct __attribute__((__packed__))
         {
-            prev_anchor->next = anchor_ptr->next;
-        }
-    }
-    free(anchor_ptr);
-    anchor_count--;
-}
+            uint8_t vertex_count;
+            struct Building_Vertex vertex[BUILDING_PKT_VERTICES];
+        };
+        uint8_t data[MAX_DATA_LEN - 5]; // Whole received packet fits
+    };
+};
 
-void remove_all_anchors()
-{
-    struct Anchor *temp_anchor;
-    if (front != NULL)
-    {
-        do
-        {
-            temp_anchor = front;
-            front = front->next;
-            free(temp_anchor);
-        } while (front != NULL);
-    }
+#define ANCHOR_PKT_3D_LEN (offsetof(struct Payload, z) + sizeof(float))
+#define RANGING_INIT_LEN (offsetof(struct Payload, coords) + sizeof(struct Coordinates))
+#define RANGING_INIT_MAP_LEN (offsetof(struct Payload, map_id) + sizeof(uint32_t))
+BUILD_ASSERT(WIRE_FRAME_SIZE <= MAX_DATA_LEN, "Anchor table frames exceed the receive buffer");
 
-    rear = NULL;
-    anchor_count = 0;
-}
+#define BUILDING_PKT_LEN(count) (offsetof(struct Payload, vertex) + (count) * sizeof(struct Building_Vertex))
 
 void show_anchors()
 {
@@ -178,7 +120,7 @@ void show_anchors()
         do
         {
             LOG_INF("Anchor ID: %x RSSI: %d  Distance: %d",
-                    temp_anchor->host_id, temp_anchor->RSSI, temp_anchor->distance);
+                    temp_anchor->host_id, temp_anchor->RSSI, (int)temp_anchor->distance);
             // LOG_INF("Re: Anchor ID: %x RSSI: %d  Distance: %d",
             //        temp_anchor->host_id, temp_anchor->re_RSSI, temp_anchor->re_distance);
             temp_anchor = temp_anchor->next;
@@ -190,497 +132,297 @@ void show_anchors()
     }
 }
 
-/*****************    Intersection Points Queue Operation     *****************/
-
-struct IPs
+/*
+Copies the vertices out of the packed packet and builds the edge tables.
+*/
+bool set_building_outline(const struct Payload *payload)
 {
-    struct Coordinates coords;
-    struct IPs *next;
-};
-
-#define IPs_LIST1 0x00
-#define IPs_LIST2 0x01
-#define POLYGON_IPs 0x02
+    float x[LOC_MAX_VERTICES], y[LOC_MAX_VERTICES];
+    int i;
 
-struct IPs *ips_list1_front = NULL;
-struct IPs *ips_list1_rear = NULL;
-
-struct IPs *ips_list2_front = NULL;
-struct IPs *ips_list2_rear = NULL;
-
-struct IPs *ips_polygon_front = NULL;
-struct IPs *ips_polygon_rear = NULL;
-
-bool equate_coordinates(struct Coordinates coord1, struct Coordinates coord2)
-{
-    if ((coord1.x == coord2.x) && (coord1.y == coord2.y))
-        return true;
-    else
+    if (payload->vertex_count > LOC_MAX_VERTICES)
         return false;
-}
-
-bool already_existing_intersection(struct Coordinates coords, uint8_t IPs_Type)
-{
-    struct IPs *temp_ip = NULL;
-
-    if (IPs_Type == IPs_LIST1)
+    for (i = 0; i < payload->vertex_count; i++)
     {
-        temp_ip = ips_list1_front;
+        x[i] = payload->vertex[i].x;
+        y[i] = payload->vertex[i].y;
     }
-    else if (IPs_Type == IPs_LIST2)
-    {
-        temp_ip = ips_list2_front;
-    }
-
-    do
-    {
-        if ((equate_coordinates(coords, temp_ip->coords)))
-        {
-            return true;
-        }
-        temp_ip = temp_ip->next;
-    } while (temp_ip != NULL);
-    return false;
+    return set_building(x, y, payload->vertex_count);
 }
 
-void add_intersection(struct Coordinates coords, uint8_t IPs_Type)
+#if defined(CONFIG_LOCALIZATION_MAP_CACHE)
+/*
+************ Map Cache ************
+The records of the last anchor table that matched its map id, as the master
+sent them, kept in the settings storage under "loc/map". A RANGING_INIT
+carries the map id; if the master's map is the same it answers with the map
+id alone and the anchors are loaded from here.
+*/
+struct Map_Cache
 {
+    uint32_t map_id;
+    uint16_t len; // Record bytes, 0 if nothing is cached
+    uint8_t version;
+    uint8_t records[LOC_MAP_CACHE_SIZE];
+};
 
-    struct IPs *n_ip = malloc(sizeof(struct IPs));
-    n_ip->coords = coords;
-    n_ip->next = NULL;
+static struct Map_Cache map_cache;
 
-    if (IPs_Type == IPs_LIST1)
-    {
-        if (ips_list1_rear == NULL)
-        {
-            ips_list1_front = n_ip;
-            ips_list1_rear = n_ip;
-        }
-        else
-        {
-            if (!(already_existing_intersection(coords, IPs_Type)))
-            {
-                ips_list1_rear->next = n_ip;
-                ips_list1_rear = ips_list1_rear->next;
-            }
-        }
-    }
-    else if (IPs_Type == IPs_LIST2)
-    {
-        if (ips_list2_rear == NULL)
-        {
-            ips_list2_front = n_ip;
-            ips_list2_rear = n_ip;
-        }
-        else
-        {
-            if (!already_existing_intersection(coords, IPs_Type))
-            {
-                ips_list2_rear->next = n_ip;
-                ips_list2_rear = ips_list2_rear->next;
-            }
-        }
-    }
-}
+#define MAP_CACHE_HEADER_SIZE offsetof(struct Map_Cache, records)
 
-int get_intersection_count(uint8_t IPs_Type)
+static int map_cache_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg)
 {
-    int count = 0;
-    struct IPs *temp_ip;
+    const char *next;
+    ssize_t ret;
 
-    if (IPs_Type == IPs_LIST1)
-    {
-        if (ips_list1_front != NULL)
-        {
-            temp_ip = ips_list1_front;
-            do
-            {
-                // LOG_INF("IP: [%d, %d]", temp_ip->coords.x, temp_ip->coords.y);
-                count++;
-                temp_ip = temp_ip->next;
-            } while (temp_ip != NULL);
-        }
-        else
-            LOG_INF("Intersection Points Queue Empty.");
-    }
-    else if (IPs_Type == IPs_LIST2)
-    {
-        if (ips_list2_front != NULL)
-        {
-            temp_ip = ips_list2_front;
-            do
-            {
-                // LOG_INF("IP: [%d, %d]", temp_ip->coords.x, temp_ip->coords.y);
-                count++;
-                temp_ip = temp_ip->next;
-            } while (temp_ip != NULL);
-        }
-        else
-            LOG_INF("Intersection Points Queue Empty.");
-    }
-    return count;
-}
+    if (!settings_name_steq(name, "map", &next) || next != NULL)
+        return -ENOENT;
+    if (len < MAP_CACHE_HEADER_SIZE || len > sizeof(map_cache))
+        return -EINVAL;
 
-void remove_all_intersections(uint8_t IPs_Type)
-{
-    struct IPs *temp_ip;
-
-    if (IPs_Type == IPs_LIST1)
+    ret = read_cb(cb_arg, &map_cache, len);
+    if (ret < 0 || (ssize_t)map_cache.len != ret - (ssize_t)MAP_CACHE_HEADER_SIZE)
     {
-        if (ips_list1_front != NULL)
-        {
-            do
-            {
-                temp_ip = ips_list1_front;
-                ips_list1_front = ips_list1_front->next;
-                free(temp_ip);
-            } while (ips_list1_front != NULL);
-        }
-        ips_list1_rear = NULL;
-    }
-    else if (IPs_Type == IPs_LIST2)
-    {
-        if (ips_list2_front != NULL)
-        {
-            do
-            {
-                temp_ip = ips_list2_front;
-                ips_list2_front = ips_list2_front->next;
-                free(temp_ip);
-            } while (ips_list2_front != NULL);
-        }
-        ips_list2_rear = NULL;
+        map_cache.len = 0;
+        return ret < 0 ? (int)ret : -EINVAL;
     }
+    return 0;
 }
 
+SETTINGS_STATIC_HANDLER_DEFINE(loc, "loc", NULL, map_cache_set, NULL, NULL);
+
 /*
-bool equate_intersections(struct Coordinates coords, uint8_t IPs_Type)
+Stores a verified table unless the cache already holds the same map.
+*/
+static void save_map_cache(const struct Wire_Table *table)
 {
+    int ret;
 
-    struct IPs *temp_ip = NULL;
-
-    if (IPs_Type == IPs_LIST1)
+    if (table->len <= 0)
     {
-        temp_ip = ips_list1_front;
-    }
-    else if (IPs_Type == IPs_LIST2)
-    {
-        temp_ip = ips_list2_front;
+        LOG_INF("Anchor map %08x too large to cache (max %d bytes).", table->map_id, LOC_MAP_CACHE_SIZE);
+        return;
     }
-    do
-    {
-        if (equate_coordinates(temp_ip->coords, coords))
-        {
-            return true;
-        }
-        temp_ip = temp_ip->next;
-    } while (temp_ip != NULL);
-    return false;
-}
-*/
+    if (map_cache.len > 0 && map_cache.map_id == table->map_id)
+        return;
 
-bool is_inside_building(struct Coordinates coords)
-{
-    float x = coords.x;
-    float y = coords.y;
-    if (x > bottom_left_corner.x && x < top_right_corner.x && y > bottom_left_corner.y && y < top_right_corner.y)
-    {
-        return true;
-    }
+    map_cache.map_id = table->map_id;
+    map_cache.version = table->version;
+    map_cache.len = (uint16_t)table->len;
+    memcpy(map_cache.records, table->records, table->len);
+    ret = settings_save_one("loc/map", &map_cache, MAP_CACHE_HEADER_SIZE + map_cache.len);
+    if (ret < 0)
+        LOG_ERR("Anchor map cache write failed (%d).", ret);
     else
-        return false;
+        LOG_INF("Anchor map %08x cached (%d bytes).", map_cache.map_id, map_cache.len);
 }
+#endif
 
+#if defined(CONFIG_LOCALIZATION_TRACE)
 /*
-Removes duplicates from IPs_1 list to IPs_2 list
+Trace records are printed as "TRC:<hex>" lines next to the log output, so a
+plain serial capture can be fed to loc_replay.
 */
-/*
-int remove_duplicate_intersections()
+uint8_t trace_buf[TRACE_ROUND_SIZE(LOC_MAX_ANCHORS * LOC_MAX_SAMPLES)];
+char trace_line[2 * sizeof(trace_buf) + 1];
+
+void emit_trace(int len)
 {
-    LOG_INF("In Removing Duplicate Intersection Points.");
-    int count = 0;
-    struct IPs *temp_ip;
-    if (ips_list1_front != NULL)
+    static const char hex[] = "0123456789abcdef";
+    int i;
+
+    if (len <= 0)
+        return;
+    for (i = 0; i < len; i++)
     {
-        do
-        {
-            temp_ip = ips_list1_front;
-            if (ips_list2_rear == NULL)
-            {
-                add_intersection(temp_ip->coords, IPs_LIST2);
-            }
-            else
-            {
-                if (!(equate_intersections(temp_ip->coords, IPs_LIST2)))
-                {
-                    if (is_inside_building(temp_ip->coords))
-                    {
-                        add_intersection(temp_ip->coords, IPs_LIST2);
-                        count++;
-                    }
-                }
-            }
-            ips_list1_front = ips_list1_front->next;
-            free(temp_ip);
-        } while (ips_list1_front != NULL);
+        trace_line[2 * i] = hex[trace_buf[i] >> 4];
+        trace_line[2 * i + 1] = hex[trace_buf[i] & 0x0F];
     }
-    ips_list1_rear = NULL;
-    return count;
+    trace_line[2 * len] = '\0';
+    printk("TRC:%s\n", trace_line);
 }
+#endif
+
+/*
+Map pixels per centimetre on floor_plan_kiel.png: the anchors at (2730, 135)
+and (2730, 2705) of the testbed are 2570 pixels and 1992 cm apart.
 */
+static const float ratio = 2570.0f / 1992.0f;
 
-/**********************************************************************************/
-/************************** Geometrical Mathematics Code **************************/
-/**********************************************************************************/
+// Anchor of each anchor queue position, the anchor index of the samples.
+static struct Anchor *queue_anchor[LOC_MAX_ANCHORS];
 
-float square(float x)
+/*
+Reduces the samples of one anchor, round->samples[first..end), to its range and
+fuses the range into the tracker, which logs a position after every anchor.
+*/
+static void fuse_anchor_range(const struct Ranging_Round *round, int first, int end)
 {
-    return x * x;
+    struct Anchor *anchor_ptr = queue_anchor[round->samples[first].anchor];
+#if defined(CONFIG_LOCALIZATION_TRACKER)
+    uint32_t timestamp = round->timestamp + round->samples[end - 1].dt;
+    struct Coordinates track_coords;
+#endif
+
+    update_anchor_range(anchor_ptr, &round->samples[first], end - first, ratio);
+#if defined(CONFIG_LOCALIZATION_ADAPTIVE_SAMPLING)
+    LOG_INF("Anchor %x: %d valid of %d samples.", anchor_ptr->host_id, anchor_ptr->samples, end - first);
+#endif
+#if defined(CONFIG_LOCALIZATION_TRACKER)
+    if (tracker_range(&tracker, anchor_ptr, timestamp))
+    {
+        track_coords = tracker_position(&tracker, timestamp);
+        LOG_INF("Device Location :(%d, %d).", (int)track_coords.x, (int)track_coords.y);
+    }
+#endif
 }
 
+#if defined(CONFIG_LOCALIZATION_PIPELINE)
 /*
-bool coordinates_set_intersection(struct Coordinates *coord0, struct Coordinates *coord, struct Coordinates *coord_prime)
-{
-    if (equate_coordinates(coord0, coord))
-        return true;
-    else if (equate_coordinates(coord0, coord_prime))
-        return true;
-    else
-        return false;
-}
+The solver thread owns last_fix. After every round it publishes a copy here,
+and the radio loop plans the next round from that copy, read under the same
+lock, so it never mixes half of one fix with half of the next.
 */
+static struct k_spinlock fix_hint_lock;
+static struct Coordinates fix_hint = {.flag = false, .x = -1, .y = -1};
+#endif
 
-struct Coordinates get_centroid(uint8_t IPs_Type)
+/*
+Fix the anchor selection of the next round starts from.
+*/
+static struct Coordinates get_fix_hint(void)
 {
-    struct Coordinates coords;
-    struct IPs *temp_ip = NULL;
-    int count = 0;
-    // LOG_INF("In Calculating centroid.");
-
-    if (IPs_Type == IPs_LIST1)
-        temp_ip = ips_list1_front;
-    else if (IPs_Type == IPs_LIST2)
-        temp_ip = ips_list2_front;
-
-    do
-    {
-        coords.x += temp_ip->coords.x;
-        coords.y += temp_ip->coords.y;
-
-        count++;
-        temp_ip = temp_ip->next;
-    } while (temp_ip != NULL);
-
-    coords.x = (coords.x / count);
-    coords.y = (coords.y / count);
-    coords.flag = true;
-    return coords;
+#if defined(CONFIG_LOCALIZATION_PIPELINE)
+    struct Coordinates fix;
+    k_spinlock_key_t key = k_spin_lock(&fix_hint_lock);
+
+    fix = fix_hint;
+    k_spin_unlock(&fix_hint_lock, key);
+    return fix;
+#else
+    return last_fix;
+#endif
 }
 
-void circles_intersection(struct Anchor *anchor1, struct Anchor *anchor2, struct Coordinates *coord, struct Coordinates *coord_prime)
+/*
+Runs the solver (and the tracker) on the anchor ranges of a round. With
+CONFIG_LOCALIZATION_PIPELINE this runs on the solver thread, which is then the
+only writer of the anchor ranges, last_fix and the tracker: the ranges of the
+round are fused here, in one pass once the round is complete. The radio loop
+reads the anchor positions, stable once ranging has started, keeps the anchor
+misses itself (plan_record) and takes last_fix only through the fix hint.
+Without the pipeline every anchor is fused while ranging, as soon as its
+samples are in (see START_RANGING).
+*/
+static void process_round(const struct Ranging_Round *round)
 {
-
-    //  struct Coordinates coord, coord_prime;
-    float x2, y2, dx, dy;
-
-    float dist, a, h;
-
-    dx = anchor2->coords.x - anchor1->coords.x;
-    dy = anchor2->coords.y - anchor1->coords.y;
-
-    // LOG_INF("In Calculating circle intersection.");
-
-    dist = hypot(dx, dy);
-
-    // Check if two circles are not same || circles do not meet || one circle is inside another one
-    if ((dist == 0.0 && anchor1->distance == anchor2->distance) || (dist > (anchor1->distance + anchor2->distance)) || (dist < fabs(anchor1->distance - anchor2->distance)))
-    {
-        // LOG_INF("Intersection not possible.");
-        coord->flag = false;
-        coord_prime->flag = false;
+    struct Coordinates dev_coords;
+#if defined(CONFIG_LOCALIZATION_PIPELINE)
+    k_spinlock_key_t key;
+    int first, i;
+#endif
+#if defined(CONFIG_LOCALIZATION_TRACKER)
+    uint32_t timestamp;
+#endif
+#if defined(CONFIG_LOCALIZATION_SOLVER_TIMING)
+    timing_t solver_start, solver_end;
+    uint64_t solver_cycles;
+#endif
+
+#if defined(CONFIG_LOCALIZATION_TRACE)
+    emit_trace(trace_encode_round(trace_buf, sizeof(trace_buf), round->cycle, round->timestamp, round->samples,
+                                  round->count));
+#endif
+
+#if defined(CONFIG_LOCALIZATION_PIPELINE)
+    // Anchors left out of the round (anchor selection) have no range.
+    reset_anchor_ranges();
+    for (first = 0; first < round->count; first = i)
+    {
+        for (i = first; i < round->count && round->samples[i].anchor == round->samples[first].anchor; i++)
+            ;
+        fuse_anchor_range(round, first, i);
     }
-    else
-    {
-        a = (square(anchor1->distance) - square(anchor2->distance) + square(dist)) / (2.0 * dist);
-        h = sqrt(square(anchor1->distance) - square(a));
-
-        x2 = anchor1->coords.x + (dx * a / dist);
-        y2 = anchor1->coords.y + (dy * a / dist);
-
-        coord->x = ceil(x2 + (dy * h / dist));
-        coord_prime->x = ceil(x2 - (dy * h / dist));
-
-        coord->y = ceil(y2 - (dx * h / dist));
-        coord_prime->y = ceil(y2 + (dx * h / dist));
-
-        coord->flag = true;
-        coord_prime->flag = true;
-
-        // LOG_INF("Intersection : (%d, %d) (%d, %d)", coord->x, coord->y, coord_prime->x, coord_prime->y);
+#endif
+#if defined(CONFIG_LOCALIZATION_TRACKER)
+    timestamp = round->timestamp;
+    if (round->count > 0)
+        timestamp += round->samples[round->count - 1].dt;
+#endif
+
+#if defined(CONFIG_LOCALIZATION_SOLVER_TIMING)
+    solver_start = timing_counter_get();
+#endif
+    dev_coords = locate_device();
+#if defined(CONFIG_LOCALIZATION_SOLVER_TIMING)
+    solver_end = timing_counter_get();
+    solver_cycles = timing_cycles_get(&solver_start, &solver_end);
+    LOG_INF("Solver %s: %u cycles, %u ns", solver_names[solver_engine], (uint32_t)solver_cycles,
+            (uint32_t)timing_cycles_to_ns(solver_cycles));
+#endif
+#if defined(CONFIG_LOCALIZATION_PIPELINE)
+    key = k_spin_lock(&fix_hint_lock);
+    fix_hint = last_fix;
+    k_spin_unlock(&fix_hint_lock, key);
+#endif
+#if defined(CONFIG_LOCALIZATION_TRACKER)
+    tracker_round(&tracker, dev_coords, timestamp);
+#endif
+    if (dev_coords.flag)
+    {
+#if defined(CONFIG_LOCALIZATION_TRACKER)
+        LOG_INF("Raw Fix :(%d, %d).", (int)dev_coords.x, (int)dev_coords.y);
+#else
+        LOG_INF("Device Location :(%d, %d).", (int)dev_coords.x, (int)dev_coords.y);
+#endif
+        if (tiered_solving)
+            LOG_INF("Fix Tier: %s (%s %u, %s %u, %s %u).", tier_names[fix_tier], tier_names[FIX_TIER_MINMAX],
+                    tier_count[FIX_TIER_MINMAX], tier_names[FIX_TIER_PREVIOUS], tier_count[FIX_TIER_PREVIOUS],
+                    tier_names[FIX_TIER_FULL], tier_count[FIX_TIER_FULL]);
+        if (height_mode == HEIGHT_3D)
+            LOG_INF("Device Height : %d.", (int)device_height);
+        else if (solver_engine == SOLVER_NLLS && fix_tier == FIX_TIER_FULL)
+            LOG_INF("Covariance: [%d %d %d] Iterations: %d", (int)nlls_result.cov_xx,
+                    (int)nlls_result.cov_xy, (int)nlls_result.cov_yy, nlls_result.iterations);
     }
 }
 
-bool is_inside(struct Anchor *anchor, struct Coordinates coords)
-{
-
-    float circle_x = anchor->coords.x;
-    float circle_y = anchor->coords.y;
-
-    float x = coords.x;
-    float y = coords.y;
-    // if (!(is_inside_building(coords)))
-    //     return false;
-    if (square(x - circle_x) + square(y - circle_y) <= square((anchor->distance) + 5))
-        return true;
-    else
-        return false;
-}
-
-int is_inside_circles(struct Coordinates coords)
-{
-
-    int count = 0;
-    struct Anchor *temp_anchor;
-    temp_anchor = front;
-    do
-    {
-        if (temp_anchor->distance > 0)
-        {
-            if (is_inside(temp_anchor, coords))
-            {
-                count++;
-            }
-        }
-        temp_anchor = temp_anchor->next;
-    } while (temp_anchor != NULL);
-    return count;
-}
-
-int get_polygon(uint8_t from_Type, uint8_t to_Type, int error, int active_anchors)
-{
-    int count = 0;
-    int circle_count = 0;
-    struct IPs *temp_ip = NULL;
-
-    if (from_Type == IPs_LIST1)
-        temp_ip = ips_list1_front;
-    else if (from_Type == IPs_LIST2)
-        temp_ip = ips_list2_front;
-
-    do
-    {
-        circle_count = is_inside_circles(temp_ip->coords);
-        // LOG_INF("In %d circles", circle_count);
-        if (circle_count >= (active_anchors - error))
-        {
-            add_intersection(temp_ip->coords, to_Type);
-            count++;
-        }
-        temp_ip = temp_ip->next;
-    } while (temp_ip != NULL);
-    return count;
-}
-
-struct Coordinates get_dev_location()
-{
-    struct Coordinates dev_coords = {
-        .flag = false,
-        .x = -1,
-        .y = -1,
-    };
-    struct Coordinates coord, coord_prime;
-
-    struct Coordinates *coord_ptr, *coord_prime_ptr;
-    coord_ptr = &coord;
-    coord_prime_ptr = &coord_prime;
-
-    struct Anchor *anchor_ptr_i;
-    struct Anchor *anchor_ptr_j;
-    int ret;
-    //  bool first_iter = true;
-    //  dev_coord.flag = NULL;
-    //  temp_coord.flag = NULL;
-
-    int error_rate = 0;
-    int active_anchors = 0;
-
-    coord.flag = false;
-    coord_prime.flag = false;
-
-    anchor_ptr_i = front;
-    do
-    {
-        if (anchor_ptr_i->distance > 0)
-        {
-            anchor_ptr_j = front;
-            do
-            {
-                if (anchor_ptr_i != anchor_ptr_j)
-                {
-                    if (anchor_ptr_j->distance > 0)
-                    {
-                        circles_intersection(anchor_ptr_i, anchor_ptr_j, coord_ptr, coord_prime_ptr);
-                        // LOG_INF("Coordinates Flags %d %d", coord.flag, coord_prime.flag);
-                        if (coord.flag && coord_prime.flag)
-                        {
-                            // LOG_INF("In Adding Intersction.");
-                            add_intersection(coord, IPs_LIST1);
-                            add_intersection(coord_prime, IPs_LIST1);
-                            // get_intersection_count(ips_front, ips_rear);
-                        }
-                    }
-                }
-
-                anchor_ptr_j = anchor_ptr_j->next;
-            } while (anchor_ptr_j != NULL);
-
-            active_anchors++;
-        }
-
-        anchor_ptr_i = anchor_ptr_i->next;
-    } while (anchor_ptr_i != NULL);
-
-    // LOG_INF("Total Intersections: %d", get_intersection_count(IPs_LIST1));
-// remove_all_intersections(IPs_LIST1);
-
+#if defined(CONFIG_LOCALIZATION_PIPELINE)
 /*
-// Below function dumps the non-duplicate data in new IPs queue and frees the previous IPs list
-ret = remove_duplicate_intersections();
-LOG_INF("Filtered Intersections: %d", ret);
-remove_all_intersections(IPs_LIST1);
+The radio loop fills rounds in the ring while the solver thread empties it.
+The ring itself is lock-free; the semaphores only count published and free
+slots so each side can sleep instead of polling.
 */
-POLYGON_CALC:
-    ret = get_polygon(IPs_LIST1, IPs_LIST2, error_rate, active_anchors);
-    // LOG_INF("Polygon Points: %d", ret);
+static struct Round_Ring round_ring;
+K_SEM_DEFINE(round_ready, 0, LOC_ROUND_RING);
+K_SEM_DEFINE(round_free, LOC_ROUND_RING, LOC_ROUND_RING);
 
-    if (ret > 2)
-    {
-        dev_coords = get_centroid(IPs_LIST2);
-        remove_all_intersections(IPs_LIST2);
-    }
-    /*
-    else if (ret > 1)
-    {
-        dev_coords = get_centroid(IPs_LIST2);
-        remove_all_intersections(IPs_LIST2);
-    }
-    */
+static void solver_thread(void *p1, void *p2, void *p3)
+{
+    struct Ranging_Round *round;
 
-    else
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    while (1)
     {
-        if (error_rate < 1)
-        {
-            error_rate = 1;
-            goto POLYGON_CALC;
-        }
-        remove_all_intersections(IPs_LIST2);
+        k_sem_take(&round_ready, K_FOREVER);
+        round = round_ring_peek(&round_ring);
+        if (round == NULL)
+            continue;
+        process_round(round);
+        round_ring_release(&round_ring);
+        k_sem_give(&round_free);
     }
-
-    remove_all_intersections(IPs_LIST1);
-    return dev_coords;
 }
 
+K_THREAD_DEFINE(solver_tid, CONFIG_LOCALIZATION_PIPELINE_STACK_SIZE, solver_thread, NULL, NULL, NULL,
+                CONFIG_LOCALIZATION_PIPELINE_PRIORITY, 0, 0);
+#else
+static struct Ranging_Round single_round;
+#endif
+
 // main function
 void main(void)
 {
@@ -704,6 +446,19 @@ void main(void)
     // struct Anchor *prev_anchor = NULL;
     // struct Anchor *temp_anchor;
     struct lora_ranging_params ranging_result;
+    struct Ranging_Round *round;
+    struct Range_Sample *sample;
+    uint16_t anchor_index;
+    static struct Ranging_Plan plan;
+    struct Coordinates fix;
+#if defined(CONFIG_LOCALIZATION_ADAPTIVE_SAMPLING)
+    struct Range_Stats stats;
+#endif
+    int planned;
+#if !defined(CONFIG_LOCALIZATION_PIPELINE)
+    int first_sample;
+#endif
+    uint32_t cycle = 0;
 
     // General Variables
     int16_t rssi;
@@ -712,13 +467,14 @@ void main(void)
     bool ranging_done = false;
     uint8_t operation = RECEIVE;
 
-    int sample_count = 5;
-    float sum = 0;
-    float avg_fact = 0;
+#if defined(CONFIG_LOCALIZATION_TRACKER)
+    int sample_count = MIN(CONFIG_LOCALIZATION_TRACKER_SAMPLES, LOC_MAX_SAMPLES);
+#else
+    int sample_count = MIN(5, LOC_MAX_SAMPLES);
+#endif
     int samples = 0;
-    float ratio = 2570 / 1992;
-    float avg_dist = 0;
     bool anchor_pkt_possible = false;
+    static struct Wire_Table table;
 
     if (!device_is_ready(lora_dev))
     {
@@ -726,6 +482,22 @@ void main(void)
         return;
     }
 
+#if defined(CONFIG_LOCALIZATION_SOLVER_TIMING)
+    timing_init();
+    timing_start();
+#endif
+
+#if defined(CONFIG_LOCALIZATION_MAP_CACHE)
+    ret = settings_subsys_init();
+    if (ret == 0)
+        ret = settings_load_subtree("loc");
+    if (ret < 0)
+        LOG_ERR("Settings unavailable (%d), anchor map not cached.", ret);
+    else if (map_cache.len > 0)
+        LOG_INF("Anchor map %08x in cache (%d bytes).", map_cache.map_id, map_cache.len);
+#endif
+    wire_table_begin(&table);
+
     config.frequency = 2445000000;
     config.bandwidth = BW_1600;
     config.datarate = SF_9;
@@ -769,6 +541,8 @@ void main(void)
                 if (len == -(EAGAIN))
                 {
                     remove_all_anchors();
+                    remove_all_calibrations();
+                    remove_building();
                     operation = RANGING_INIT;
                 }
                 else
@@ -788,11 +562,78 @@ void main(void)
             payload.operation = RANGING_INIT;
             payload.host_id = host_id;
             payload.coords = dev_coords;
+            wire_table_begin(&table);
 
             k_sleep(K_MSEC(20));
-            ret = lora_send(lora_dev, payload_ptr, sizeof(payload));
+#if defined(CONFIG_LOCALIZATION_MAP_CACHE)
+            if (map_cache.len > 0)
+            {
+                payload.map_id = map_cache.map_id;
+                ret = lora_send(lora_dev, payload_ptr, RANGING_INIT_MAP_LEN);
+            }
+            else
+#endif
+                ret = lora_send(lora_dev, payload_ptr, RANGING_INIT_LEN);
             k_sleep(K_MSEC(30));
 
+            operation = RECEIVE;
+            break;
+        case BUILDING_PKT:
+            if (payload.host_id == host_id)
+            {
+                if (len >= (int)BUILDING_PKT_LEN(0) && len >= (int)BUILDING_PKT_LEN(payload.vertex_count) &&
+                    set_building_outline(&payload))
+                {
+                    LOG_INF("Building Outline Received (%d vertices).", payload.vertex_count);
+                    anchor_pkt_possible = true;
+                }
+                else
+                    LOG_ERR("Invalid building outline (%d vertices, max %d).", payload.vertex_count,
+                            LOC_MAX_VERTICES);
+            }
+
+            operation = RECEIVE;
+            break;
+        case ANCHOR_TABLE_PKT:
+            if (payload.host_id == host_id)
+            {
+                ret = wire_load_frame(payload_ptr, len, &table);
+                if (ret < 0)
+                    LOG_ERR("Invalid anchor table frame (%d bytes).", len);
+                else
+                    LOG_INF("Anchor Table Frame: %d records, %d anchors.", ret, anchor_count);
+                if (table.done)
+                {
+#if defined(CONFIG_LOCALIZATION_MAP_CACHE)
+                    if (wire_table_current(&table) && map_cache.len > 0 && table.map_id == map_cache.map_id)
+                    {
+                        ret = wire_load_records(map_cache.version, map_cache.records, map_cache.len);
+                        if (ret < 0)
+                        {
+                            // Unreadable with this build, download the map again.
+                            LOG_ERR("Anchor map cache invalid, dropped.");
+                            map_cache.len = 0;
+                            settings_delete("loc/map");
+                            remove_all_anchors();
+                            remove_all_calibrations();
+                            remove_building();
+                            operation = RANGING_INIT;
+                            break;
+                        }
+                        LOG_INF("Anchor map %08x loaded from cache: %d records, %d anchors.", map_cache.map_id,
+                                ret, anchor_count);
+                    }
+                    else if (wire_table_verified(&table))
+                        save_map_cache(&table);
+                    else if (table.has_map_id)
+                        LOG_ERR("Anchor table does not match map %08x, not cached.", table.map_id);
+#endif
+                    // The done marker stands in for ALL_DONE_PKT.
+                    operation = ALL_DONE_PKT;
+                    break;
+                }
+            }
+
             operation = RECEIVE;
             break;
         case CORNER_PKT:
@@ -821,13 +662,27 @@ void main(void)
         case ANCHOR_PKT:
             if (anchor_pkt_possible)
             {
-                if (!add_anchor(payload.host_id, payload.coords))
+                if (!add_anchor(payload.host_id, payload.coords, (len >= (int)ANCHOR_PKT_3D_LEN) ? payload.z : 0))
                 {
-                    LOG_INF("Received Already Existing Anchor.");
+                    if (anchor_count >= LOC_MAX_ANCHORS)
+                        LOG_ERR("Anchor pool full (%d).", LOC_MAX_ANCHORS);
+                    else
+                        LOG_INF("Received Already Existing Anchor.");
                 }
             }
             operation = RECEIVE;
             break;
+        case CALIB_PKT:
+            if (anchor_pkt_possible)
+            {
+                if (set_calibration(payload.host_id, &payload.calib))
+                    LOG_INF("Calibration of Anchor %x: offset %d cm, scale %d/1000.", payload.host_id,
+                            (int)payload.calib.offset, (int)(payload.calib.scale * 1000));
+                else
+                    LOG_ERR("Calibration table full (%d).", LOC_MAX_ANCHORS);
+            }
+            operation = RECEIVE;
+            break;
         case ALL_DONE_PKT:
             if (payload.host_id != host_id)
             {
@@ -838,6 +693,16 @@ void main(void)
             // show_anchors();
             if (anchor_count > 2)
             {
+                anchor_index = 0;
+                for (anchor_ptr = front; anchor_ptr != NULL; anchor_ptr = anchor_ptr->next)
+                    queue_anchor[anchor_index++] = anchor_ptr;
+                locate_prepare();
+#if defined(CONFIG_LOCALIZATION_TRACE)
+                if (building.count > 0)
+                    emit_trace(trace_encode_building(trace_buf, sizeof(trace_buf)));
+                emit_trace(trace_encode_map(trace_buf, sizeof(trace_buf), ratio));
+                emit_trace(trace_encode_calib(trace_buf, sizeof(trace_buf)));
+#endif
                 lora_setup_ranging(lora_dev, &config, host_id, ROLE_SENDER);
                 operation = START_RANGING;
             }
@@ -849,47 +714,84 @@ void main(void)
         case START_RANGING:
             // k_sleep(K_MSEC(10));
 
-            anchor_ptr = front;
-            do
+#if defined(CONFIG_LOCALIZATION_PIPELINE)
+            // Wait for a free slot if the solver is a whole ring behind.
+            k_sem_take(&round_free, K_FOREVER);
+            round = round_ring_claim(&round_ring);
+#else
+            round = &single_round;
+#endif
+
+            fix = get_fix_hint();
+#if defined(CONFIG_LOCALIZATION_ANCHOR_SELECTION)
+            plan_ranging(&plan, fix, CONFIG_LOCALIZATION_SELECT_ANCHORS,
+                         (cycle % CONFIG_LOCALIZATION_SELECT_FULL_SCAN) == 0);
+#else
+            plan_ranging(&plan, fix, anchor_count, true);
+#endif
+            round->cycle = cycle++;
+            round->count = 0;
+            round->timestamp = k_uptime_get_32();
+#if !defined(CONFIG_LOCALIZATION_PIPELINE)
+            // Anchors left out of the round (anchor selection) have no range.
+            reset_anchor_ranges();
+#endif
+            for (planned = 0; planned < plan.count; planned++)
             {
+                anchor_ptr = plan.anchor[planned];
+                anchor_index = plan.index[planned];
                 // k_sleep(K_MSEC(30));
                 samples = 0;
-                sum = 0;
-                avg_fact = 0;
+#if !defined(CONFIG_LOCALIZATION_PIPELINE)
+                first_sample = round->count;
+#endif
+#if defined(CONFIG_LOCALIZATION_ADAPTIVE_SAMPLING)
+                range_stats_reset(&stats, anchor_ptr);
+#endif
 
                 while (samples < sample_count)
                 {
                     ranging_result = lora_transmit_ranging(lora_dev, &config, (anchor_ptr->host_id));
-                    if (ranging_result.status != false && ranging_result.distance > 0)
-                    {
-                        sum = sum + ranging_result.distance;
-                        avg_fact++;
-                    }
+
+                    sample = &round->samples[round->count++];
+                    sample->anchor = anchor_index;
+                    sample->status = ranging_result.status;
+                    sample->RSSI = ranging_result.RSSIVal;
+                    sample->distance = ranging_result.distance;
+                    sample->dt = (uint16_t)(k_uptime_get_32() - round->timestamp);
+                    if (sample->status && sample->distance > 0)
+                        plan.valid[planned]++;
 
                     samples++;
+#if defined(CONFIG_LOCALIZATION_ADAPTIVE_SAMPLING)
+                    if (range_stats_add(&stats, sample))
+                        break;
+#endif
                 }
-                if (sum > 0.0)
-                {
-                    avg_dist = sum / avg_fact;
-                    anchor_ptr->distance = ceil(avg_dist * ratio); // Distance in pixels via ratio multiplication.
-                    anchor_ptr->RSSI = ranging_result.RSSIVal;
-                }
-                else
+#if !defined(CONFIG_LOCALIZATION_PIPELINE)
+                // Live tracker update after every anchor, the solver runs once the round is in.
+                fuse_anchor_range(round, first_sample, round->count);
+#endif
+
+                if (plan_converged(&plan, planned + 1, fix))
                 {
-                    anchor_ptr->distance = -1;
-                    anchor_ptr->RSSI = 0;
+                    planned++;
+                    break;
                 }
-
-                anchor_ptr = anchor_ptr->next;
-
-            } while (anchor_ptr != NULL);
-
-            // show_anchors();
-            //  prev_anchor = NULL;
-            dev_coords = get_dev_location();
+            }
+            plan_record(&plan, planned);
+#if defined(CONFIG_LOCALIZATION_ANCHOR_SELECTION)
+            LOG_INF("Ranged %d of %d anchors%s.", planned, anchor_count, plan.full_scan ? " (full scan)" : "");
+#endif
+
+#if defined(CONFIG_LOCALIZATION_PIPELINE)
+            // The solver takes it from here, the next round starts right away.
+            round_ring_publish(&round_ring);
+            k_sem_give(&round_ready);
+#else
+            process_round(round);
+#endif
             // ranging_done = true;
-            if (dev_coords.flag)
-                LOG_INF("Device Location :(%d, %d).", dev_coords.x, dev_coords.y);
 
             /*
             if(anchor_count >= 3)
@@ -0,0 +1,25 @@
+# Fails if the linked image references double precision helpers of libgcc.
+#
+# usage: cmake -DNM=<nm> -DELF=<zephyr.elf> -P check_single_precision.cmake
+
+if(NOT NM)
+  message(FATAL_ERROR "No nm found to check ${ELF} for soft-double helpers")
+endif()
+if(NOT EXISTS ${ELF})
+  message(FATAL_ERROR "${ELF} not found, cannot check it for soft-double helpers")
+endif()
+
+execute_process(COMMAND ${NM} ${ELF}
+  OUTPUT_VARIABLE symbols
+  RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "${NM} failed on ${ELF}")
+endif()
+
+string(REGEX MATCHALL
+  "__aeabi_(d[a-z0-9]+|cd[a-z0-9]+|f2d|i2d|ui2d|l2d|ul2d)|__(add|sub|mul|div|neg)df3|__extendsfdf2|__truncdfsf2|__(fix|fixuns)df[sd]i|__float(un)?[sd]idf|__(eq|ne|lt|le|gt|ge|un|c)df2"
+  helpers "${symbols}")
+if(helpers)
+  list(REMOVE_DUPLICATES helpers)
+  message(FATAL_ERROR "Soft-double helpers linked into ${ELF}: ${helpers}")
+endif()
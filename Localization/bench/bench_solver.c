@@ -0,0 +1,399 @@
+/*
+ * Indoor Localization solver benchmark
+ *
+ * Generates synthetic anchor layouts from the testbed positions, scales them
+ * to larger anchor counts, adds Gaussian range noise and times locate_device()
+ * for every solver. Reports ns/fix, heap allocations/fix, peak RSS and the
+ * position error against the true tag position.
+ *
+ * Every row runs in its own forked process, so its peak RSS is what that
+ * solver touched, not the high-water mark of the rows before it. The
+ * particle filter tracks the device from fix to fix and is fed a continuous
+ * walk; the other solvers get independent random tag positions.
+ *
+ * usage: loc_bench [-n fixes] [-a anchors,...] [-s noise,...] [-e solver,...] [-r seed]
+ */
+
+#include <localization.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#define BUILDING_MIN 135.0f
+#define BUILDING_MAX 2730.0f
+#define MAX_LIST 16
+#define WALK_STEP 40.0f // Pixels per fix, about a walking pace at the fix rate
+#define WALK_CHECKS 5   // Wall checks along a step, 8 pixels apart
+#define WALK_TRIES 32
+
+/* ********* Heap Accounting ********** */
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+static unsigned long heap_calls;
+
+void *__wrap_malloc(size_t size)
+{
+    heap_calls++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    heap_calls++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    heap_calls++;
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void *ptr)
+{
+    if (ptr != NULL)
+        heap_calls++;
+    __real_free(ptr);
+}
+
+/* ********* Synthetic Layouts ********** */
+
+/* NODE_POSITION of the testbed visualization (map pixels). */
+static const float testbed_anchors[7][2] = {
+    {1530, 135}, {2730, 135}, {2730, 2005}, {2730, 2705}, {2295, 875}, {135, 135}, {135, 2415},
+};
+
+static uint32_t rng_state;
+
+static uint32_t rng_next(void)
+{
+    // xorshift32, deterministic for a given seed
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static float rng_uniform(void)
+{
+    return (rng_next() >> 8) * (1.0f / 16777216.0f);
+}
+
+static float rng_gauss(void)
+{
+    float u1 = rng_uniform() + 1e-7f;
+    float u2 = rng_uniform();
+    return sqrtf(-2.0f * logf(u1)) * cosf(6.2831853f * u2);
+}
+
+/*
+The first seven anchors are the testbed positions, further anchors are placed
+on a jittered grid over the building.
+*/
+static void make_layout(int n, float *x, float *y)
+{
+    int i, side, extra = n - 7;
+    float cell;
+
+    for (i = 0; i < n && i < 7; i++)
+    {
+        x[i] = testbed_anchors[i][0];
+        y[i] = testbed_anchors[i][1];
+    }
+    if (extra <= 0)
+        return;
+
+    side = (int)ceilf(sqrtf((float)extra));
+    cell = (BUILDING_MAX - BUILDING_MIN) / side;
+    for (i = 0; i < extra; i++)
+    {
+        x[7 + i] = BUILDING_MIN + cell * ((i % side) + rng_uniform());
+        y[7 + i] = BUILDING_MIN + cell * ((i / side) + rng_uniform());
+    }
+}
+
+/*
+Tells whether a straight step stays off the walls, checked every few pixels.
+*/
+static bool walk_clear(float x0, float y0, float x1, float y1)
+{
+#if LOC_SOLVER_PARTICLE
+    int i;
+
+    for (i = 1; i <= WALK_CHECKS; i++)
+    {
+        if (!is_free_space(x0 + (x1 - x0) * i / WALK_CHECKS, y0 + (y1 - y0) * i / WALK_CHECKS))
+            return false;
+    }
+#endif
+    return x1 >= BUILDING_MIN && x1 <= BUILDING_MAX && y1 >= BUILDING_MIN && y1 <= BUILDING_MAX;
+}
+
+/*
+Tag positions for the fixes. A tracking solver gets a walk through the free
+space of the floor plan that turns gradually and picks a new heading at walls,
+the others independent uniform positions.
+*/
+static bool make_tags(uint8_t engine, int fixes, float *tx, float *ty)
+{
+    float x, y, heading;
+    int i, tries;
+
+    if (engine != SOLVER_PARTICLE)
+    {
+        for (i = 0; i < fixes; i++)
+        {
+            tx[i] = BUILDING_MIN + rng_uniform() * (BUILDING_MAX - BUILDING_MIN);
+            ty[i] = BUILDING_MIN + rng_uniform() * (BUILDING_MAX - BUILDING_MIN);
+        }
+        return false;
+    }
+
+    do
+    {
+        x = BUILDING_MIN + rng_uniform() * (BUILDING_MAX - BUILDING_MIN);
+        y = BUILDING_MIN + rng_uniform() * (BUILDING_MAX - BUILDING_MIN);
+    } while (!walk_clear(x, y, x, y));
+    heading = 6.2831853f * rng_uniform();
+    for (i = 0; i < fixes; i++)
+    {
+        heading += 0.3f * rng_gauss();
+        for (tries = 0; tries < WALK_TRIES; tries++)
+        {
+            if (walk_clear(x, y, x + WALK_STEP * cosf(heading), y + WALK_STEP * sinf(heading)))
+            {
+                x += WALK_STEP * cosf(heading);
+                y += WALK_STEP * sinf(heading);
+                break;
+            }
+            heading = 6.2831853f * rng_uniform();
+        }
+        tx[i] = x; // Stands still if boxed in
+        ty[i] = y;
+    }
+    return true;
+}
+
+/* ********* Benchmark ********** */
+
+static int parse_list(const char *arg, float *values)
+{
+    char buf[256];
+    char *tok;
+    int n = 0;
+
+    strncpy(buf, arg, sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = '\0';
+    for (tok = strtok(buf, ","); tok != NULL && n < MAX_LIST; tok = strtok(NULL, ","))
+        values[n++] = strtof(tok, NULL);
+    return n;
+}
+
+static int compare_float(const void *a, const void *b)
+{
+    float fa = *(const float *)a;
+    float fb = *(const float *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void run(uint8_t engine, int n, float noise, int fixes, uint32_t seed)
+{
+    static float ax[LOC_MAX_ANCHORS], ay[LOC_MAX_ANCHORS];
+    float *ranges = malloc(sizeof(float) * fixes * n);
+    float *tx = malloc(sizeof(float) * fixes);
+    float *ty = malloc(sizeof(float) * fixes);
+    float *errors = malloc(sizeof(float) * fixes);
+    struct Coordinates coords = {.flag = true};
+    struct Coordinates fix;
+    struct Anchor *anchor_ptr;
+    struct rusage usage;
+    unsigned long heap_before, heap_after;
+    double start, elapsed;
+    float err_sum = 0;
+    int i, k, located = 0;
+    bool walk;
+
+    rng_state = seed;
+    make_layout(n, ax, ay);
+
+    remove_all_anchors();
+    for (k = 0; k < n; k++)
+    {
+        coords.x = ax[k];
+        coords.y = ay[k];
+        add_anchor(0x1000 + k, coords, 0);
+    }
+    locate_prepare();
+
+    walk = make_tags(engine, fixes, tx, ty);
+    for (i = 0; i < fixes; i++)
+    {
+        for (k = 0; k < n; k++)
+        {
+            float r = ceilf(hypotf(ax[k] - tx[i], ay[k] - ty[i]) + noise * rng_gauss());
+            ranges[i * n + k] = r < 1 ? 1 : r;
+        }
+    }
+
+    solver_engine = engine;
+    last_fix.flag = false;
+#if LOC_SOLVER_PARTICLE
+    particle_reset();
+#endif
+
+    heap_before = heap_calls;
+    start = now_ns();
+    for (i = 0; i < fixes; i++)
+    {
+        for (anchor_ptr = front, k = 0; anchor_ptr != NULL; anchor_ptr = anchor_ptr->next, k++)
+            anchor_ptr->distance = ranges[i * n + k];
+
+        fix = locate_device();
+        errors[i] = fix.flag ? hypotf(fix.x - tx[i], fix.y - ty[i]) : INFINITY;
+    }
+    elapsed = now_ns() - start;
+    heap_after = heap_calls;
+
+    for (i = 0; i < fixes; i++)
+    {
+        if (isfinite(errors[i]))
+        {
+            err_sum += errors[i];
+            located++;
+        }
+    }
+    qsort(errors, fixes, sizeof(float), compare_float);
+    getrusage(RUSAGE_SELF, &usage);
+
+    printf("%-8s %-6s %7d %6.1f %12.0f %10.2f %6.1f %9.1f %9.1f %12ld\n",
+           solver_names[engine], walk ? "walk" : "random", n, noise, elapsed / fixes,
+           (double)(heap_after - heap_before) / fixes,
+           100.0 * located / fixes,
+           located ? err_sum / located : NAN,
+           located ? errors[(located * 95 - 1) / 100] : NAN,
+           usage.ru_maxrss);
+
+    free(ranges);
+    free(tx);
+    free(ty);
+    free(errors);
+}
+
+/*
+Runs one row in a child process. Falls back to this process if fork fails,
+the peak RSS is then shared with the rows before.
+*/
+static void run_forked(uint8_t engine, int n, float noise, int fixes, uint32_t seed)
+{
+    pid_t pid;
+
+    fflush(stdout);
+    pid = fork();
+    if (pid < 0)
+    {
+        run(engine, n, noise, fixes, seed);
+        return;
+    }
+    if (pid == 0)
+    {
+        run(engine, n, noise, fixes, seed);
+        fflush(stdout);
+        _exit(0);
+    }
+    waitpid(pid, NULL, 0);
+}
+
+int main(int argc, char **argv)
+{
+    float anchor_counts[MAX_LIST] = {3, 7, 16, 64, 256};
+    float noises[MAX_LIST] = {0, 10, 30};
+    bool selected[SOLVER_COUNT];
+    int n_counts = 5, n_noises = 3;
+    int fixes = 100;
+    uint32_t seed = 12345;
+    char buf[256];
+    char *tok;
+    int opt, e, a, s;
+
+    for (e = 0; e < SOLVER_COUNT; e++)
+        selected[e] = solver_built((uint8_t)e);
+
+    while ((opt = getopt(argc, argv, "n:a:s:e:r:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            fixes = atoi(optarg);
+            break;
+        case 'a':
+            n_counts = parse_list(optarg, anchor_counts);
+            break;
+        case 's':
+            n_noises = parse_list(optarg, noises);
+            break;
+        case 'e':
+            strncpy(buf, optarg, sizeof(buf) - 1);
+            buf[sizeof(buf) - 1] = '\0';
+            for (e = 0; e < SOLVER_COUNT; e++)
+                selected[e] = false;
+            for (tok = strtok(buf, ","); tok != NULL; tok = strtok(NULL, ","))
+            {
+                e = find_solver(tok);
+                if (e < 0)
+                {
+                    fprintf(stderr, "unknown solver %s\n", tok);
+                    return 1;
+                }
+                selected[e] = true;
+            }
+            break;
+        case 'r':
+            seed = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n fixes] [-a anchors,...] [-s noise,...] [-e solver,...] [-r seed]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (fixes <= 0 || seed == 0)
+    {
+        fprintf(stderr, "fixes and seed must be non-zero\n");
+        return 1;
+    }
+
+    printf("%-8s %-6s %7s %6s %12s %10s %6s %9s %9s %12s\n",
+           "solver", "tags", "anchors", "noise", "ns/fix", "allocs/fix", "fix%", "err_mean", "err_p95", "peak_rss_kB");
+    for (e = 0; e < SOLVER_COUNT; e++)
+    {
+        if (!selected[e])
+            continue;
+        for (a = 0; a < n_counts; a++)
+        {
+            if (anchor_counts[a] < 3 || anchor_counts[a] > LOC_MAX_ANCHORS)
+            {
+                fprintf(stderr, "skipping %d anchors (pool holds %d)\n", (int)anchor_counts[a], LOC_MAX_ANCHORS);
+                continue;
+            }
+            for (s = 0; s < n_noises; s++)
+                run_forked((uint8_t)e, (int)anchor_counts[a], noises[s], fixes, seed);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,21 @@
+/*
+ * Indoor Localization floor plan
+ *
+ * Occupancy map of floor_plan_kiel.png (2865 x 2839 map pixels), generated
+ * by tools/floor_plan_map.py. Do not edit. One bit per cell, set for walls,
+ * rows packed LSB first.
+ */
+
+#ifndef LOCALIZATION_FLOOR_PLAN_H_
+#define LOCALIZATION_FLOOR_PLAN_H_
+
+#include <stdint.h>
+
+#define FLOOR_PLAN_CELL_SIZE 16
+#define FLOOR_PLAN_COLUMNS 180
+#define FLOOR_PLAN_ROWS 178
+#define FLOOR_PLAN_ROW_BYTES 23
+
+extern const uint8_t floor_plan_cells[FLOOR_PLAN_ROWS * FLOOR_PLAN_ROW_BYTES];
+
+#endif /* LOCALIZATION_FLOOR_PLAN_H_ */
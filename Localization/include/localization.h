@@ -0,0 +1,512 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Anchor bookkeeping and location solvers of the mobile node. The library has
+ * no Zephyr dependency: the firmware and the host tools build the same sources.
+ * Capacities are taken from Kconfig (CONFIG_LOCALIZATION_*) when built inside
+ * Zephyr, from LOC_* definitions on the compiler command line on the host, and
+ * fall back to the defaults below otherwise.
+ */
+
+#ifndef LOCALIZATION_H_
+#define LOCALIZATION_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ********* Configuration ********** */
+
+#if !defined(LOC_MAX_ANCHORS)
+#if defined(CONFIG_LOCALIZATION_MAX_ANCHORS)
+#define LOC_MAX_ANCHORS CONFIG_LOCALIZATION_MAX_ANCHORS
+#else
+#define LOC_MAX_ANCHORS 16
+#endif
+#endif
+
+#if !defined(LOC_MAX_INTERSECTIONS)
+#if defined(CONFIG_LOCALIZATION_MAX_INTERSECTIONS)
+#define LOC_MAX_INTERSECTIONS CONFIG_LOCALIZATION_MAX_INTERSECTIONS
+#else
+#define LOC_MAX_INTERSECTIONS 256
+#endif
+#endif
+
+#if !defined(LOC_IPS_HASH_SIZE)
+#if defined(CONFIG_LOCALIZATION_IPS_HASH_SIZE)
+#define LOC_IPS_HASH_SIZE CONFIG_LOCALIZATION_IPS_HASH_SIZE
+#else
+#define LOC_IPS_HASH_SIZE 512
+#endif
+#endif
+
+#if !defined(LOC_IPS_MERGE_TOLERANCE)
+#if defined(CONFIG_LOCALIZATION_IPS_MERGE_TOLERANCE)
+#define LOC_IPS_MERGE_TOLERANCE CONFIG_LOCALIZATION_IPS_MERGE_TOLERANCE
+#else
+#define LOC_IPS_MERGE_TOLERANCE 1
+#endif
+#endif
+
+#if !defined(LOC_NLLS_MAX_ITERATIONS)
+#if defined(CONFIG_LOCALIZATION_NLLS_MAX_ITERATIONS)
+#define LOC_NLLS_MAX_ITERATIONS CONFIG_LOCALIZATION_NLLS_MAX_ITERATIONS
+#else
+#define LOC_NLLS_MAX_ITERATIONS 10
+#endif
+#endif
+
+#if !defined(LOC_MAX_SAMPLES)
+#if defined(CONFIG_LOCALIZATION_MAX_SAMPLES)
+#define LOC_MAX_SAMPLES CONFIG_LOCALIZATION_MAX_SAMPLES
+#else
+#define LOC_MAX_SAMPLES 8
+#endif
+#endif
+
+#if !defined(LOC_ADAPTIVE_MIN_SAMPLES)
+#if defined(CONFIG_LOCALIZATION_ADAPTIVE_MIN_SAMPLES)
+#define LOC_ADAPTIVE_MIN_SAMPLES CONFIG_LOCALIZATION_ADAPTIVE_MIN_SAMPLES
+#else
+#define LOC_ADAPTIVE_MIN_SAMPLES 2
+#endif
+#endif
+
+#if !defined(LOC_ADAPTIVE_TOLERANCE)
+#if defined(CONFIG_LOCALIZATION_ADAPTIVE_TOLERANCE)
+#define LOC_ADAPTIVE_TOLERANCE CONFIG_LOCALIZATION_ADAPTIVE_TOLERANCE
+#else
+#define LOC_ADAPTIVE_TOLERANCE 30
+#endif
+#endif
+
+#if !defined(LOC_ADAPTIVE_MAX_FAILURES)
+#if defined(CONFIG_LOCALIZATION_ADAPTIVE_MAX_FAILURES)
+#define LOC_ADAPTIVE_MAX_FAILURES CONFIG_LOCALIZATION_ADAPTIVE_MAX_FAILURES
+#else
+#define LOC_ADAPTIVE_MAX_FAILURES 2
+#endif
+#endif
+
+#if !defined(LOC_PARTICLES)
+#if defined(CONFIG_LOCALIZATION_PARTICLES)
+#define LOC_PARTICLES CONFIG_LOCALIZATION_PARTICLES
+#else
+#define LOC_PARTICLES 256
+#endif
+#endif
+
+#if !defined(LOC_PARTICLE_RANGE_SIGMA)
+#if defined(CONFIG_LOCALIZATION_PARTICLE_RANGE_SIGMA)
+#define LOC_PARTICLE_RANGE_SIGMA CONFIG_LOCALIZATION_PARTICLE_RANGE_SIGMA
+#else
+#define LOC_PARTICLE_RANGE_SIGMA 130
+#endif
+#endif
+
+#if !defined(LOC_PARTICLE_MOTION_SIGMA)
+#if defined(CONFIG_LOCALIZATION_PARTICLE_MOTION_SIGMA)
+#define LOC_PARTICLE_MOTION_SIGMA CONFIG_LOCALIZATION_PARTICLE_MOTION_SIGMA
+#else
+#define LOC_PARTICLE_MOTION_SIGMA 150
+#endif
+#endif
+
+#if !defined(LOC_GRID_CELLS)
+#if defined(CONFIG_LOCALIZATION_GRID_CELLS)
+#define LOC_GRID_CELLS CONFIG_LOCALIZATION_GRID_CELLS
+#else
+#define LOC_GRID_CELLS 32
+#endif
+#endif
+
+#if !defined(LOC_RANSAC_ITERATIONS)
+#if defined(CONFIG_LOCALIZATION_RANSAC_ITERATIONS)
+#define LOC_RANSAC_ITERATIONS CONFIG_LOCALIZATION_RANSAC_ITERATIONS
+#else
+#define LOC_RANSAC_ITERATIONS 40
+#endif
+#endif
+
+#if !defined(LOC_RANSAC_THRESHOLD)
+#if defined(CONFIG_LOCALIZATION_RANSAC_THRESHOLD)
+#define LOC_RANSAC_THRESHOLD CONFIG_LOCALIZATION_RANSAC_THRESHOLD
+#else
+#define LOC_RANSAC_THRESHOLD 150
+#endif
+#endif
+
+#if !defined(LOC_TAG_HEIGHT)
+#if defined(CONFIG_LOCALIZATION_TAG_HEIGHT)
+#define LOC_TAG_HEIGHT CONFIG_LOCALIZATION_TAG_HEIGHT
+#else
+#define LOC_TAG_HEIGHT 0
+#endif
+#endif
+
+#if !defined(LOC_MAX_VERTICES)
+#if defined(CONFIG_LOCALIZATION_MAX_VERTICES)
+#define LOC_MAX_VERTICES CONFIG_LOCALIZATION_MAX_VERTICES
+#else
+#define LOC_MAX_VERTICES 30
+#endif
+#endif
+
+#if !defined(LOC_MAP_CACHE_SIZE)
+#if defined(CONFIG_LOCALIZATION_MAP_CACHE_SIZE)
+#define LOC_MAP_CACHE_SIZE CONFIG_LOCALIZATION_MAP_CACHE_SIZE
+#else
+#define LOC_MAP_CACHE_SIZE 512
+#endif
+#endif
+
+#if !defined(LOC_TIER_THRESHOLD)
+#if defined(CONFIG_LOCALIZATION_TIER_THRESHOLD)
+#define LOC_TIER_THRESHOLD CONFIG_LOCALIZATION_TIER_THRESHOLD
+#else
+#define LOC_TIER_THRESHOLD 40
+#endif
+#endif
+
+#if !defined(LOC_SELECT_GDOP)
+#if defined(CONFIG_LOCALIZATION_SELECT_GDOP)
+#define LOC_SELECT_GDOP CONFIG_LOCALIZATION_SELECT_GDOP
+#else
+#define LOC_SELECT_GDOP 150
+#endif
+#endif
+
+#if !defined(LOC_TRACKER_RANGE_SIGMA)
+#if defined(CONFIG_LOCALIZATION_TRACKER_RANGE_SIGMA)
+#define LOC_TRACKER_RANGE_SIGMA CONFIG_LOCALIZATION_TRACKER_RANGE_SIGMA
+#else
+#define LOC_TRACKER_RANGE_SIGMA 130
+#endif
+#endif
+
+#if !defined(LOC_TRACKER_ACCEL_NOISE)
+#if defined(CONFIG_LOCALIZATION_TRACKER_ACCEL_NOISE)
+#define LOC_TRACKER_ACCEL_NOISE CONFIG_LOCALIZATION_TRACKER_ACCEL_NOISE
+#else
+#define LOC_TRACKER_ACCEL_NOISE 130
+#endif
+#endif
+
+/*
+The grid and particle solvers keep large static tables. Zephyr builds compile
+them only when their Kconfig option is set, host builds always have them.
+*/
+#if !defined(LOC_SOLVER_GRID)
+#if defined(CONFIG_LOCALIZATION_GRID) || !defined(__ZEPHYR__)
+#define LOC_SOLVER_GRID 1
+#else
+#define LOC_SOLVER_GRID 0
+#endif
+#endif
+
+#if !defined(LOC_SOLVER_PARTICLE)
+#if defined(CONFIG_LOCALIZATION_PARTICLE_FILTER) || !defined(__ZEPHYR__)
+#define LOC_SOLVER_PARTICLE 1
+#else
+#define LOC_SOLVER_PARTICLE 0
+#endif
+#endif
+
+/* ********* Types ********** */
+
+struct __attribute__((__packed__)) Coordinates
+{
+    bool flag; //  Validated Coordinates if TRUE else not validated
+    float x;
+    float y;
+};
+
+struct Anchor
+{
+    uint32_t host_id;
+    struct Coordinates coords;
+    float z; // Mounting height above the floor in map pixels
+    float distance;
+    int16_t RSSI;
+    uint8_t misses;  // Consecutive ranging cycles without a valid sample, see plan_record()
+    uint8_t samples; // Valid samples behind distance in the last cycle
+    float spread;    // Dispersion of those samples in pixels
+    struct Anchor *next;
+};
+
+/*
+One ranging exchange with an anchor, as returned by lora_transmit_ranging().
+*/
+struct Range_Sample
+{
+    uint16_t anchor; // Position of the anchor in the anchor queue
+    bool status;
+    int16_t RSSI;
+    float distance; // in centimeters
+    uint16_t dt;    // Milliseconds since the start of the ranging round
+};
+
+/*
+Linear range correction of one anchor, in centimeters. Sent by the master in
+CALIB_PKT, hence packed.
+*/
+struct __attribute__((__packed__)) Range_Calibration
+{
+    float offset;     // Added after scaling, antenna delay and placement bias
+    float scale;
+    float rssi_slope; // Centimeters per dB of RSSI above rssi_ref
+    int16_t rssi_ref;
+};
+
+/*
+Running mean and variance (Welford) of the samples of one anchor, in
+centimeters, used to stop ranging an anchor early.
+*/
+struct Range_Stats
+{
+    const struct Range_Calibration *calib;
+    uint8_t valid;
+    uint8_t failed;
+    float mean;
+    float m2; // Sum of squared deviations from the mean
+};
+
+/*
+Anchors taking part in one location cycle, stored as contiguous arrays so the
+pairwise kernel walks plain float arrays instead of the anchor queue.
+*/
+struct Anchor_Set
+{
+    int count;
+    uint16_t slot[LOC_MAX_ANCHORS]; // Index of the anchor in anchor_pool
+    float x[LOC_MAX_ANCHORS];
+    float y[LOC_MAX_ANCHORS];
+    float z[LOC_MAX_ANCHORS];
+    float r[LOC_MAX_ANCHORS];
+    float w[LOC_MAX_ANCHORS]; // Range weight in (0, 1] from the sample spread
+};
+
+/*
+Building outline, a simple polygon of count vertices in map pixels. Every
+non-horizontal edge keeps its y span and its line as x = x0 + slope * y, so
+the point-in-polygon test needs no division.
+*/
+struct Building
+{
+    int count;
+    float vertex_x[LOC_MAX_VERTICES];
+    float vertex_y[LOC_MAX_VERTICES];
+    int edge_count;
+    float y_min[LOC_MAX_VERTICES];
+    float y_max[LOC_MAX_VERTICES];
+    float slope[LOC_MAX_VERTICES];
+    float x0[LOC_MAX_VERTICES];
+};
+
+/*
+Anchors to range in one cycle, best first.
+*/
+struct Ranging_Plan
+{
+    int count;
+    bool full_scan; // Whole queue in queue order, no early stop
+    uint16_t index[LOC_MAX_ANCHORS]; // Position of the anchor in the anchor queue
+    uint8_t valid[LOC_MAX_ANCHORS];  // Valid samples of the entry, filled while ranging
+    struct Anchor *anchor[LOC_MAX_ANCHORS];
+};
+
+struct IPs
+{
+    struct Coordinates coords;
+    int hits; // Points merged into this one, itself included
+    struct IPs *next;
+};
+
+#define IPs_LIST1 0x00 // Every pairwise intersection
+#define IPs_LIST2 0x01 // The polygon, points inside enough circles
+#define IPs_LISTS 0x02
+
+#define HEIGHT_FLAT 0x00      // Heights ignored, ranges used as measured
+#define HEIGHT_PROJECTED 0x01 // Ranges projected onto the tag plane (2.5D)
+#define HEIGHT_3D 0x02        // Position and height solved together
+
+#define RANGE_MEAN 0x00
+#define RANGE_MEDIAN 0x01
+#define RANGE_MAD 0x02
+#define RANGE_TRIMMED 0x03
+#define RANGE_ESTIMATORS 0x04
+
+#define SOLVER_POLYGON 0x00
+#define SOLVER_NLLS 0x01
+#define SOLVER_LLS 0x02
+#define SOLVER_PARTICLE 0x03
+#define SOLVER_GRID 0x04
+#define SOLVER_RANSAC 0x05
+#define SOLVER_COUNT 0x06
+
+#define FIX_TIER_MINMAX 0x00   // Min-max box estimate
+#define FIX_TIER_PREVIOUS 0x01 // Previous fix still fits the ranges
+#define FIX_TIER_FULL 0x02     // Selected solver
+#define FIX_TIERS 0x03
+
+struct NLLS_Result
+{
+    struct Coordinates coords;
+    float cov_xx; // Position covariance in pixels^2
+    float cov_xy;
+    float cov_yy;
+    int iterations;
+};
+
+struct Tracker
+{
+    bool started;
+    uint8_t missed;     // Consecutive cycles without an accepted range
+    uint16_t accepted;  // Ranges fused in the current cycle
+    uint32_t timestamp; // Milliseconds, time of the state
+    float state[4];     // x, y in pixels, vx, vy in pixels/s
+    float cov[4][4];
+};
+
+/* ********* Anchor Queue (anchors.c) ********** */
+
+extern struct Anchor anchor_pool[LOC_MAX_ANCHORS];
+extern struct Anchor *front;
+extern struct Anchor *rear;
+extern int anchor_count;
+
+extern struct Coordinates bottom_left_corner;
+extern struct Coordinates top_right_corner;
+
+bool already_existing(uint32_t host_id);
+bool add_anchor(uint32_t host_id, struct Coordinates coords, float z);
+void remove_anchor(struct Anchor *prev_anchor, struct Anchor *anchor_ptr);
+void remove_all_anchors(void);
+
+/* ********* Building Outline (building.c) ********** */
+
+extern struct Building building;
+
+bool set_building(const float *x, const float *y, int count);
+void remove_building(void);
+bool is_inside_building(struct Coordinates coords);
+
+/* ********* Range Estimation (ranging.c) ********** */
+
+extern uint8_t range_estimator;
+extern uint8_t height_mode;
+extern float tag_height;
+extern const char *const estimator_names[RANGE_ESTIMATORS];
+
+int find_estimator(const char *name);
+
+void update_anchor_range(struct Anchor *anchor, const struct Range_Sample *samples, int count, float ratio);
+void reset_anchor_ranges(void);
+void range_stats_reset(struct Range_Stats *stats, const struct Anchor *anchor);
+bool range_stats_add(struct Range_Stats *stats, const struct Range_Sample *sample);
+
+/* ********* Range Calibration (calibration.c) ********** */
+
+extern int calibration_count;
+
+bool set_calibration(uint32_t host_id, const struct Range_Calibration *calib);
+const struct Range_Calibration *find_calibration(uint32_t host_id);
+const struct Range_Calibration *get_calibration(int index, uint32_t *host_id);
+void remove_all_calibrations(void);
+float calibrate_range(const struct Range_Calibration *calib, float distance, int16_t RSSI);
+
+/* ********* Anchor Selection (select.c) ********** */
+
+void plan_ranging(struct Ranging_Plan *plan, struct Coordinates fix, int max_anchors, bool full_scan);
+void plan_record(const struct Ranging_Plan *plan, int ranged);
+bool plan_converged(const struct Ranging_Plan *plan, int ranged, struct Coordinates fix);
+
+/* ********* Intersection Points (intersections.c) ********** */
+
+bool already_existing_intersection(struct Coordinates coords, uint8_t IPs_Type);
+void add_intersection(struct Coordinates coords, uint8_t IPs_Type);
+void merge_intersection(struct Coordinates coords, int hits, uint8_t IPs_Type);
+struct IPs *get_intersections(uint8_t IPs_Type);
+int get_intersection_count(uint8_t IPs_Type);
+void remove_all_intersections(uint8_t IPs_Type);
+
+/* ********* Polygon Centroid Solver (geometry.c) ********** */
+
+extern struct Anchor_Set anchor_set;
+
+float square(float x);
+void pair_prepare(void);
+int load_anchor_set(struct Anchor_Set *set);
+int pairwise_intersections(const struct Anchor_Set *set, struct Coordinates *points);
+int is_inside_circles(struct Coordinates coords);
+int get_polygon(uint8_t from_Type, uint8_t to_Type, int error, int active_anchors);
+struct Coordinates get_centroid(uint8_t IPs_Type);
+struct Coordinates get_dev_location(void);
+
+/* ********* Least Squares Solvers (nlls.c, lls.c) ********** */
+
+bool solve_nlls(const struct Anchor_Set *set, struct Coordinates start, struct NLLS_Result *result);
+void lls_prepare(void);
+struct Coordinates solve_lls(const struct Anchor_Set *set);
+
+/* ********* Particle Filter (particle.c) ********** */
+
+bool is_free_space(float x, float y);
+void particle_reset(void);
+struct Coordinates solve_particle(const struct Anchor_Set *set);
+
+/* ********* Distance Grid Solver (grid.c) ********** */
+
+void grid_prepare(void);
+struct Coordinates solve_grid(const struct Anchor_Set *set);
+
+/* ********* 3D Multilateration (nlls3d.c) ********** */
+
+struct Coordinates solve_nlls3d(const struct Anchor_Set *set, struct Coordinates start, float *z);
+
+/* ********* RANSAC Solver (ransac.c) ********** */
+
+struct Coordinates solve_ransac(const struct Anchor_Set *set);
+
+/* ********* Min-Max Estimate (minmax.c) ********** */
+
+struct Coordinates solve_minmax(const struct Anchor_Set *set);
+float range_residual(const struct Anchor_Set *set, float x, float y);
+
+/* ********* Solver Selection (locate.c) ********** */
+
+extern uint8_t solver_engine;
+extern const char *const solver_names[SOLVER_COUNT];
+extern struct Coordinates last_fix;
+extern struct NLLS_Result nlls_result;
+extern float device_height;
+extern bool tiered_solving;
+extern float tier_threshold;
+extern uint8_t fix_tier;
+extern uint32_t tier_count[FIX_TIERS];
+extern const char *const tier_names[FIX_TIERS];
+
+bool solver_built(uint8_t engine);
+int find_solver(const char *name);
+void locate_prepare(void);
+struct Coordinates locate_device(void);
+
+/* ********* Tracking (tracker.c) ********** */
+
+extern struct Tracker tracker;
+
+void tracker_reset(struct Tracker *t);
+void tracker_predict(struct Tracker *t, uint32_t timestamp);
+bool tracker_range(struct Tracker *t, const struct Anchor *anchor, uint32_t timestamp);
+void tracker_round(struct Tracker *t, struct Coordinates fix, uint32_t timestamp);
+struct Coordinates tracker_position(const struct Tracker *t, uint32_t timestamp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOCALIZATION_H_ */
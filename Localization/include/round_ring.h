@@ -0,0 +1,78 @@
+/*
+ * Indoor Localization ranging round ring
+ *
+ * Lock-free single-producer/single-consumer ring of ranging rounds, so the
+ * radio loop can range round k+1 while the solver works on round k. Slots are
+ * filled in place: the producer claims a slot, writes the samples and
+ * publishes it, the consumer peeks it, solves and releases it. Neither side
+ * ever blocks in the ring; waiting for data or room is left to the caller
+ * (a semaphore on the firmware).
+ *
+ * head is written by the producer only and tail by the consumer only, each
+ * published with release and read with acquire ordering, so a slot's contents
+ * are visible before its index is.
+ */
+
+#ifndef LOCALIZATION_ROUND_RING_H_
+#define LOCALIZATION_ROUND_RING_H_
+
+#include <localization.h>
+
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if !defined(LOC_ROUND_RING)
+#if defined(CONFIG_LOCALIZATION_PIPELINE_DEPTH)
+#define LOC_ROUND_RING CONFIG_LOCALIZATION_PIPELINE_DEPTH
+#else
+#define LOC_ROUND_RING 2
+#endif
+#endif
+
+#if (LOC_ROUND_RING & (LOC_ROUND_RING - 1)) != 0
+#error "LOC_ROUND_RING must be a power of two"
+#endif
+
+#define LOC_ROUND_SAMPLES (LOC_MAX_ANCHORS * LOC_MAX_SAMPLES)
+
+/*
+Samples of one ranging cycle, those of one anchor consecutive.
+*/
+struct Ranging_Round
+{
+    uint32_t cycle;
+    uint32_t timestamp; // Milliseconds, start of the round
+    int count;
+    struct Range_Sample samples[LOC_ROUND_SAMPLES];
+};
+
+struct Round_Ring
+{
+    atomic_uint head; // Next slot to publish, producer side
+    atomic_uint tail; // Next slot to consume, consumer side
+    struct Ranging_Round round[LOC_ROUND_RING];
+};
+
+/* Empties the ring. Neither side may be using it. */
+void round_ring_reset(struct Round_Ring *ring);
+
+/* Producer: free slot to fill, or NULL if the ring is full. */
+struct Ranging_Round *round_ring_claim(struct Round_Ring *ring);
+
+/* Producer: hands the claimed slot to the consumer. */
+void round_ring_publish(struct Round_Ring *ring);
+
+/* Consumer: oldest published round, or NULL if the ring is empty. */
+struct Ranging_Round *round_ring_peek(struct Round_Ring *ring);
+
+/* Consumer: returns the peeked slot to the producer. */
+void round_ring_release(struct Round_Ring *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOCALIZATION_ROUND_RING_H_ */
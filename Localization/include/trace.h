@@ -0,0 +1,77 @@
+/*
+ * Indoor Localization ranging traces
+ *
+ * Compact little-endian binary records of the anchor map and of every ranging
+ * round, so a field capture can be replayed through the solvers offline.
+ *
+ * Record layout: MAGIC | TYPE | LENGTH (u16, whole record) | BODY
+ *
+ * TRACE_MAP   : RATIO (f32) | BOTTOM_LEFT x,y (f32) | TOP_RIGHT x,y (f32) |
+ *               COUNT (u16) | COUNT x [HOST_ID (u32) | X (f32) | Y (f32) | Z (f32)]
+ * TRACE_ROUND : CYCLE (u32) | TIMESTAMP ms (u32) | COUNT (u16) |
+ *               COUNT x [ANCHOR (u16) | STATUS (u8) | RSSI (i16) | DISTANCE cm (f32) | DT ms (u16)]
+ * TRACE_CALIB : COUNT (u16) | COUNT x [HOST_ID (u32) | OFFSET cm (f32) | SCALE (f32) |
+ *               RSSI_SLOPE cm/dB (f32) | RSSI_REF (i16)]
+ * TRACE_BUILDING : COUNT (u16) | COUNT x [X (f32) | Y (f32)]
+ */
+
+#ifndef LOCALIZATION_TRACE_H_
+#define LOCALIZATION_TRACE_H_
+
+#include <localization.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRACE_MAGIC 0x4C
+#define TRACE_MAP 0x01
+#define TRACE_ROUND 0x02
+#define TRACE_CALIB 0x03
+#define TRACE_BUILDING 0x04
+
+#define TRACE_HEADER_SIZE 4
+#define TRACE_MAP_ANCHOR_SIZE 16
+#define TRACE_SAMPLE_SIZE 11
+#define TRACE_CALIB_ENTRY_SIZE 18
+#define TRACE_VERTEX_SIZE 8
+
+#define TRACE_MAP_SIZE(anchors) (TRACE_HEADER_SIZE + 22 + (anchors)*TRACE_MAP_ANCHOR_SIZE)
+#define TRACE_ROUND_SIZE(samples) (TRACE_HEADER_SIZE + 10 + (samples)*TRACE_SAMPLE_SIZE)
+#define TRACE_CALIB_SIZE(entries) (TRACE_HEADER_SIZE + 2 + (entries)*TRACE_CALIB_ENTRY_SIZE)
+#define TRACE_BUILDING_SIZE(vertices) (TRACE_HEADER_SIZE + 2 + (vertices)*TRACE_VERTEX_SIZE)
+
+/* Writes the anchor queue and building corners, returns the record length or -1. */
+int trace_encode_map(uint8_t *buf, int size, float ratio);
+
+/* Writes one ranging round, returns the record length or -1. */
+int trace_encode_round(uint8_t *buf, int size, uint32_t cycle, uint32_t timestamp,
+                       const struct Range_Sample *samples, int count);
+
+/* Writes the range calibration table, returns the record length or -1. */
+int trace_encode_calib(uint8_t *buf, int size);
+
+/* Writes the building outline, returns the record length or -1. */
+int trace_encode_building(uint8_t *buf, int size);
+
+/* Returns the length of the complete record at buf, 0 if more bytes are needed, -1 if invalid. */
+int trace_record_length(const uint8_t *buf, int len);
+
+/* Rebuilds the anchor queue and corners from a TRACE_MAP record. Returns the anchor count or -1. */
+int trace_load_map(const uint8_t *buf, int len, float *ratio);
+
+/* Replaces the range calibration table from a TRACE_CALIB record. Returns the entry count or -1. */
+int trace_load_calib(const uint8_t *buf, int len);
+
+/* Replaces the building outline from a TRACE_BUILDING record. Returns the vertex count or -1. */
+int trace_load_building(const uint8_t *buf, int len);
+
+/* Decodes a TRACE_ROUND record. Returns the sample count or -1. */
+int trace_decode_round(const uint8_t *buf, int len, uint32_t *cycle, uint32_t *timestamp,
+                       struct Range_Sample *samples, int max_samples);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOCALIZATION_TRACE_H_ */
@@ -0,0 +1,214 @@
+/*
+ * Indoor Localization over-the-air anchor table
+ *
+ * The master packs the anchor map into as few frames as possible instead of
+ * one packet per anchor: every frame is a sequence of typed records, and the
+ * done marker travels inline in the last one.
+ *
+ * The map id, the hash of all records of the table, travels in a WIRE_MAP_ID
+ * record right before the done marker. A mobile that cached the map under the
+ * same id gets a table of just these two records and loads the cache instead.
+ *
+ * Frame layout: DEVICE_ID (u32) | ANCHOR_TABLE_PKT (u8) | VERSION (u8) | RECORD...
+ *
+ * WIRE_VERSION_FLOAT, coordinates as f32 map pixels:
+ * WIRE_ANCHOR  : TYPE | HOST_ID (u32) | X (f32) | Y (f32) | Z (f32)
+ * WIRE_CALIB   : TYPE | HOST_ID (u32) | OFFSET cm (f32) | SCALE (f32) |
+ *                RSSI_SLOPE cm/dB (f32) | RSSI_REF (i16)
+ * WIRE_OUTLINE : TYPE | COUNT (u8) | COUNT x [X (f32) | Y (f32)]
+ * WIRE_DONE    : TYPE, the anchor table is complete
+ * WIRE_MAP_ID  : TYPE | MAP_ID (u32), FNV-1a of the record bytes before it,
+ *                frame headers left out
+ *
+ * WIRE_VERSION_COMPACT, coordinates as i16 whole map pixels (about +-250 m),
+ * consecutive anchors sharing one record header:
+ * WIRE_ANCHOR  : TYPE | COUNT (u8) | FLAGS (u8) |
+ *                COUNT x [HOST_ID (u32) | X (i16) | Y (i16) | Z (i16) if WIRE_ANCHOR_Z]
+ * WIRE_CALIB   : TYPE | HOST_ID (u32) | OFFSET 0.1 cm (i16) | SCALE - 1 in 1e-4 (i16) |
+ *                RSSI_SLOPE 0.01 cm/dB (i16) | RSSI_REF (i8)
+ * WIRE_OUTLINE : TYPE | COUNT (u8) | COUNT x [X (i16) | Y (i16)]
+ * WIRE_DONE, WIRE_MAP_ID as above
+ *
+ * All fields are little-endian. The byte and quantization helpers are shared
+ * by the master and the mobile, and the byte helpers also by the trace records.
+ */
+
+#ifndef LOCALIZATION_WIRE_H_
+#define LOCALIZATION_WIRE_H_
+
+#include <localization.h>
+
+#include <math.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ANCHOR_TABLE_PKT 0x15
+
+#define WIRE_ANCHOR 0x01
+#define WIRE_CALIB 0x02
+#define WIRE_OUTLINE 0x03
+#define WIRE_DONE 0x04
+#define WIRE_MAP_ID 0x05
+
+#define WIRE_VERSION_FLOAT 0x01
+#define WIRE_VERSION_COMPACT 0x02
+
+#define WIRE_ANCHOR_Z 0x01 // Compact anchors carry their height
+
+#define WIRE_FRAME_SIZE 249 // Largest frame the mobile receives
+#define WIRE_HEADER_SIZE 6
+#define WIRE_DONE_SIZE 1
+#define WIRE_MAP_ID_SIZE 5
+
+#define WIRE_HASH_INIT 2166136261u
+
+#define WIRE_ANCHOR_SIZE 17
+#define WIRE_CALIB_SIZE 19
+#define WIRE_OUTLINE_SIZE(vertices) (2 + (vertices)*8)
+
+#define WIRE_RUN_SIZE 3 // Compact anchor record header
+#define WIRE_COMPACT_ANCHOR_SIZE(flags) (((flags)&WIRE_ANCHOR_Z) ? 10 : 8)
+#define WIRE_COMPACT_CALIB_SIZE 12
+#define WIRE_COMPACT_OUTLINE_SIZE(vertices) (2 + (vertices)*4)
+
+// Units of the compact fields
+#define WIRE_PIXEL_UNIT 1.0f
+#define WIRE_OFFSET_UNIT 0.1f     // cm
+#define WIRE_SCALE_UNIT 0.0001f   // Relative to a scale of 1
+#define WIRE_SLOPE_UNIT 0.01f     // cm/dB
+
+struct Wire_Frame
+{
+    int len;
+    uint8_t version;
+    int run; // Offset of the compact anchor record still open for more anchors, 0 if none
+    uint32_t hash; // Records of the previous frames of the table
+    uint8_t buf[WIRE_FRAME_SIZE];
+};
+
+/*
+Receive side of a table. The records are also kept, as received, for the map
+cache while they fit in LOC_MAP_CACHE_SIZE.
+*/
+struct Wire_Table
+{
+    uint8_t version;
+    bool done;
+    bool has_map_id;
+    uint32_t map_id;
+    uint32_t hash; // Records received so far
+    int len;       // Record bytes kept, -1 once they did not fit
+    uint8_t records[LOC_MAP_CACHE_SIZE];
+};
+
+static inline uint8_t *wire_put_u16(uint8_t *p, uint16_t value)
+{
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+    return p + 2;
+}
+
+static inline uint8_t *wire_put_u32(uint8_t *p, uint32_t value)
+{
+    p[0] = value & 0xFF;
+    p[1] = (value >> 8) & 0xFF;
+    p[2] = (value >> 16) & 0xFF;
+    p[3] = value >> 24;
+    return p + 4;
+}
+
+static inline uint8_t *wire_put_f32(uint8_t *p, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return wire_put_u32(p, bits);
+}
+
+/*
+Nearest multiple of unit, saturated to the int16 range.
+*/
+static inline int16_t wire_quantize(float value, float unit)
+{
+    float q = roundf(value / unit);
+
+    if (q > INT16_MAX)
+        return INT16_MAX;
+    if (q < INT16_MIN)
+        return INT16_MIN;
+    return (int16_t)q;
+}
+
+static inline float wire_dequantize(int16_t q, float unit)
+{
+    return q * unit;
+}
+
+static inline uint16_t wire_get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t wire_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline float wire_get_f32(const uint8_t *p)
+{
+    uint32_t bits = wire_get_u32(p);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/* Starts the first frame of a table of the given version addressed to the mobile host_id. */
+void wire_frame_begin(struct Wire_Frame *frame, uint32_t host_id, uint8_t version);
+
+/* Starts the next, empty frame of the same table once the current one is sent. */
+void wire_frame_next(struct Wire_Frame *frame);
+
+/* Hash of the records put so far, the current frame included: the map id of a complete table. */
+uint32_t wire_table_hash(const struct Wire_Frame *frame);
+
+uint32_t wire_hash(uint32_t hash, const uint8_t *p, int len);
+
+/* Append one record each. Return false, leaving the frame as it was, if it does not fit. */
+bool wire_put_anchor(struct Wire_Frame *frame, uint32_t host_id, struct Coordinates coords, float z);
+bool wire_put_calib(struct Wire_Frame *frame, uint32_t host_id, const struct Range_Calibration *calib);
+bool wire_put_outline(struct Wire_Frame *frame, const float *x, const float *y, int count);
+bool wire_put_done(struct Wire_Frame *frame);
+bool wire_put_map_id(struct Wire_Frame *frame, uint32_t map_id);
+
+void wire_table_begin(struct Wire_Table *table);
+
+/*
+Applies the records of a received frame to the anchor queue, the calibration
+table and the building outline, and adds them to table. table->done is set if
+the frame ends the table. Returns the record count, or -1 if the frame is
+malformed (records before the bad one are kept).
+*/
+int wire_load_frame(const uint8_t *buf, int len, struct Wire_Table *table);
+
+/* Applies a record stream kept by a Wire_Table, e.g. from the map cache. Returns the record count or -1. */
+int wire_load_records(uint8_t version, const uint8_t *p, int len);
+
+/* A complete table whose records match its map id. */
+static inline bool wire_table_verified(const struct Wire_Table *table)
+{
+    return table->done && table->has_map_id && table->hash == table->map_id;
+}
+
+/* A complete table of no records: the map is unchanged since map_id. */
+static inline bool wire_table_current(const struct Wire_Table *table)
+{
+    return table->done && table->has_map_id && table->hash == WIRE_HASH_INIT;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOCALIZATION_WIRE_H_ */
@@ -0,0 +1,137 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Anchor queue backed by a static pool. Anchors and intersection points are
+ * taken from fixed-size pools instead of the heap, so a location cycle never
+ * calls malloc/free.
+ */
+
+#include <localization.h>
+
+#include <stddef.h>
+
+struct Coordinates bottom_left_corner = {
+    .flag = false,
+    .x = -1,
+    .y = -1,
+};
+struct Coordinates top_right_corner = {
+    .flag = false,
+    .x = -1,
+    .y = -1,
+};
+
+/* ********* Static Pools ********** */
+
+struct Anchor anchor_pool[LOC_MAX_ANCHORS];
+static struct Anchor *anchor_free_list = NULL;
+static int anchor_pool_used = 0;
+
+static struct Anchor *alloc_anchor(void)
+{
+    struct Anchor *n_anchor = NULL;
+
+    if (anchor_free_list != NULL)
+    {
+        n_anchor = anchor_free_list;
+        anchor_free_list = anchor_free_list->next;
+    }
+    else if (anchor_pool_used < LOC_MAX_ANCHORS)
+    {
+        n_anchor = &anchor_pool[anchor_pool_used++];
+    }
+    return n_anchor;
+}
+
+static void free_anchor(struct Anchor *anchor_ptr)
+{
+    anchor_ptr->next = anchor_free_list;
+    anchor_free_list = anchor_ptr;
+}
+
+/* ********* Queue Operations ********** */
+
+struct Anchor *front = NULL;
+struct Anchor *rear = NULL;
+int anchor_count = 0;
+
+bool already_existing(uint32_t host_id)
+{
+    struct Anchor *temp_anchor;
+    temp_anchor = front;
+    do
+    {
+        if (temp_anchor->host_id == host_id)
+        {
+            return true;
+        }
+        temp_anchor = temp_anchor->next;
+    } while (temp_anchor != NULL);
+    return false;
+}
+
+bool add_anchor(uint32_t host_id, struct Coordinates coords, float z)
+{
+    struct Anchor *n_anchor;
+
+    if (rear != NULL && already_existing(host_id))
+        return false;
+
+    n_anchor = alloc_anchor();
+    if (n_anchor == NULL)
+        return false; // Anchor pool exhausted.
+    n_anchor->coords = coords;
+    n_anchor->z = z;
+    n_anchor->host_id = host_id;
+    n_anchor->distance = -1;
+    // n_anchor->re_distance = -1;
+    n_anchor->RSSI = 0;
+    n_anchor->misses = 0;
+    n_anchor->samples = 0;
+    n_anchor->spread = 0;
+    // n_anchor->re_RSSI = 0;
+    n_anchor->next = NULL;
+
+    if (rear == NULL)
+    {
+        front = n_anchor;
+        rear = n_anchor;
+    }
+    else
+    {
+        rear->next = n_anchor;
+        rear = rear->next;
+    }
+    anchor_count++;
+    return true;
+}
+
+void remove_anchor(struct Anchor *prev_anchor, struct Anchor *anchor_ptr)
+{
+    if (prev_anchor == NULL)
+    {
+        front = anchor_ptr->next;
+        if (front == NULL)
+            rear = NULL;
+    }
+    else
+    {
+        prev_anchor->next = anchor_ptr->next;
+        if (anchor_ptr->next == NULL)
+            rear = prev_anchor;
+    }
+    free_anchor(anchor_ptr);
+    anchor_count--;
+}
+
+/*
+Drops the whole queue in O(1) by rewinding the anchor pool.
+*/
+void remove_all_anchors(void)
+{
+    front = NULL;
+    rear = NULL;
+    anchor_free_list = NULL;
+    anchor_pool_used = 0;
+    anchor_count = 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Building outline and point-in-polygon test for candidate filtering.
+ */
+
+#include <localization.h>
+
+#include <math.h>
+
+/*
+set_building() turns the outline into edge tables once, when the master sends
+it: the y span of every edge and its line solved for x, x = x0 + slope * y.
+Horizontal edges never cross a horizontal ray and are left out. A test is then
+a crossing count along the ray from the point towards -x: the spans are
+half-open, y_min <= y < y_max, so a ray through a vertex counts once, and each
+crossed edge costs one multiply-add and a compare. The bounding box of the
+outline becomes the building corners, which also rejects far points before
+the edge loop.
+*/
+struct Building building;
+
+bool set_building(const float *x, const float *y, int count)
+{
+    float x1, y1, x2, y2;
+    int i, j;
+
+    if (count < 3 || count > LOC_MAX_VERTICES)
+        return false;
+
+    building.count = count;
+    building.edge_count = 0;
+    bottom_left_corner.x = top_right_corner.x = x[0];
+    bottom_left_corner.y = top_right_corner.y = y[0];
+    for (i = 0, j = count - 1; i < count; j = i++)
+    {
+        building.vertex_x[i] = x[i];
+        building.vertex_y[i] = y[i];
+        bottom_left_corner.x = fminf(bottom_left_corner.x, x[i]);
+        bottom_left_corner.y = fminf(bottom_left_corner.y, y[i]);
+        top_right_corner.x = fmaxf(top_right_corner.x, x[i]);
+        top_right_corner.y = fmaxf(top_right_corner.y, y[i]);
+
+        // Edge from vertex j to vertex i, lower end first.
+        if (y[i] == y[j])
+            continue;
+        if (y[i] < y[j])
+        {
+            x1 = x[i];
+            y1 = y[i];
+            x2 = x[j];
+            y2 = y[j];
+        }
+        else
+        {
+            x1 = x[j];
+            y1 = y[j];
+            x2 = x[i];
+            y2 = y[i];
+        }
+        building.y_min[building.edge_count] = y1;
+        building.y_max[building.edge_count] = y2;
+        building.slope[building.edge_count] = (x2 - x1) / (y2 - y1);
+        building.x0[building.edge_count] = x1 - building.slope[building.edge_count] * y1;
+        building.edge_count++;
+    }
+    bottom_left_corner.flag = true;
+    top_right_corner.flag = true;
+    return true;
+}
+
+void remove_building(void)
+{
+    building.count = 0;
+    building.edge_count = 0;
+}
+
+/*
+Inside the outline if the master sent one, else inside the rectangle of the
+two building corners.
+*/
+bool is_inside_building(struct Coordinates coords)
+{
+    float x = coords.x;
+    float y = coords.y;
+    bool inside = false;
+    int i;
+
+    if (x < bottom_left_corner.x || x > top_right_corner.x || y < bottom_left_corner.y || y > top_right_corner.y)
+        return false;
+    if (building.count == 0)
+        return x > bottom_left_corner.x && x < top_right_corner.x && y > bottom_left_corner.y && y < top_right_corner.y;
+
+    for (i = 0; i < building.edge_count; i++)
+    {
+        if (y >= building.y_min[i] && y < building.y_max[i] && x > building.x0[i] + building.slope[i] * y)
+            inside = !inside;
+    }
+    return inside;
+}
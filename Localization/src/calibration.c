@@ -0,0 +1,81 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Per-anchor range calibration table, keyed by anchor host_id.
+ */
+
+#include <localization.h>
+
+#include <stddef.h>
+
+/*
+A calibrated sample is scale * distance + offset + rssi_slope * (RSSI - rssi_ref),
+in centimeters, before the conversion to map pixels. The entries come from the
+master with the anchor map (calibration records or CALIB_PKT), so the mobile
+clears them together with the anchor queue before a new map is downloaded.
+Anchors without an entry keep their raw samples.
+*/
+struct Calibration_Entry
+{
+    uint32_t host_id;
+    struct Range_Calibration calib;
+};
+
+static struct Calibration_Entry calibration_table[LOC_MAX_ANCHORS];
+int calibration_count = 0;
+
+/*
+Adds or replaces the calibration of an anchor. Returns false if the table is full.
+*/
+bool set_calibration(uint32_t host_id, const struct Range_Calibration *calib)
+{
+    int i;
+
+    for (i = 0; i < calibration_count; i++)
+    {
+        if (calibration_table[i].host_id == host_id)
+            break;
+    }
+    if (i == LOC_MAX_ANCHORS)
+        return false;
+    if (i == calibration_count)
+        calibration_count++;
+    calibration_table[i].host_id = host_id;
+    calibration_table[i].calib = *calib;
+    return true;
+}
+
+const struct Range_Calibration *find_calibration(uint32_t host_id)
+{
+    int i;
+
+    for (i = 0; i < calibration_count; i++)
+    {
+        if (calibration_table[i].host_id == host_id)
+            return &calibration_table[i].calib;
+    }
+    return NULL;
+}
+
+/*
+Index-based access for the trace encoder. Returns NULL past the end.
+*/
+const struct Range_Calibration *get_calibration(int index, uint32_t *host_id)
+{
+    if (index < 0 || index >= calibration_count)
+        return NULL;
+    *host_id = calibration_table[index].host_id;
+    return &calibration_table[index].calib;
+}
+
+void remove_all_calibrations(void)
+{
+    calibration_count = 0;
+}
+
+float calibrate_range(const struct Range_Calibration *calib, float distance, int16_t RSSI)
+{
+    if (calib == NULL)
+        return distance;
+    return calib->scale * distance + calib->offset + calib->rssi_slope * (RSSI - calib->rssi_ref);
+}
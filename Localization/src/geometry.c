@@ -0,0 +1,306 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Intersection polygon centroid solver: circles of all ranged anchors are
+ * intersected pairwise, points inside (almost) every circle form the polygon
+ * and its centroid is the device location.
+ */
+
+#include <localization.h>
+
+#include <math.h>
+#include <stddef.h>
+
+float square(float x)
+{
+    return x * x;
+}
+
+#define MAX_PAIR_POINTS (LOC_MAX_ANCHORS * (LOC_MAX_ANCHORS - 1))
+#define CIRCLE_TOLERANCE 5
+#define RANGE_WEIGHT_SIGMA 40.0f // Pixels, range error that halves the weight
+
+struct Anchor_Set anchor_set;
+static struct Coordinates pair_points[MAX_PAIR_POINTS];
+
+/*
+Copies every anchor with a valid range into the set, returns the active count.
+The weight of a range is s^2 / (s^2 + v) with s = RANGE_WEIGHT_SIGMA and v the
+variance of the estimate, spread^2 / samples. A single sample has no spread and
+gets the weight of v = s^2.
+*/
+int load_anchor_set(struct Anchor_Set *set)
+{
+    struct Anchor *temp_anchor = front;
+    float floor2 = RANGE_WEIGHT_SIGMA * RANGE_WEIGHT_SIGMA;
+    float variance;
+    int count = 0;
+
+    while (temp_anchor != NULL)
+    {
+        if (temp_anchor->distance > 0)
+        {
+            set->slot[count] = (uint16_t)(temp_anchor - anchor_pool);
+            set->x[count] = temp_anchor->coords.x;
+            set->y[count] = temp_anchor->coords.y;
+            set->z[count] = temp_anchor->z;
+            set->r[count] = temp_anchor->distance;
+            if (temp_anchor->samples > 1)
+                variance = temp_anchor->spread * temp_anchor->spread / temp_anchor->samples;
+            else
+                variance = floor2;
+            set->w[count] = floor2 / (floor2 + variance);
+            count++;
+        }
+        temp_anchor = temp_anchor->next;
+    }
+    set->count = count;
+    return count;
+}
+
+/*
+Baseline of every unordered anchor pair, indexed by pool slot. Anchors do not
+move once the master has sent them, so pair_prepare() computes the length,
+its reciprocal and the unit direction from the lower to the higher slot once,
+and the intersection kernel is left with the range-dependent arithmetic.
+Pairs closer than PAIR_MIN_BASELINE give ill-conditioned intersections (or
+none, for anchors mounted at the same spot) and are flagged unusable.
+*/
+#define PAIR_MIN_BASELINE 20.0f // Pixels
+#define PAIR_COUNT (LOC_MAX_ANCHORS * (LOC_MAX_ANCHORS - 1) / 2)
+
+struct Anchor_Pair
+{
+    bool usable;
+    float dist;
+    float inv_dist;
+    float ux; // Unit direction from the lower slot to the higher one
+    float uy;
+};
+
+static struct Anchor_Pair pair_table[PAIR_COUNT];
+
+/*
+Index of the pair of slots a < b in the packed upper triangle.
+*/
+static inline int pair_index(int a, int b)
+{
+    return a * (2 * LOC_MAX_ANCHORS - a - 1) / 2 + (b - a - 1);
+}
+
+void pair_prepare(void)
+{
+    struct Anchor *first, *second;
+    struct Anchor_Pair *pair;
+    float dx, dy;
+    int a, b;
+
+    for (first = front; first != NULL; first = first->next)
+    {
+        for (second = first->next; second != NULL; second = second->next)
+        {
+            a = first - anchor_pool;
+            b = second - anchor_pool;
+            if (a < b)
+            {
+                dx = second->coords.x - first->coords.x;
+                dy = second->coords.y - first->coords.y;
+            }
+            else
+            {
+                dx = first->coords.x - second->coords.x;
+                dy = first->coords.y - second->coords.y;
+            }
+            pair = &pair_table[(a < b) ? pair_index(a, b) : pair_index(b, a)];
+            pair->dist = hypotf(dx, dy);
+            pair->usable = pair->dist >= PAIR_MIN_BASELINE;
+            if (!pair->usable)
+                continue;
+            pair->inv_dist = 1.0f / pair->dist;
+            pair->ux = dx * pair->inv_dist;
+            pair->uy = dy * pair->inv_dist;
+        }
+    }
+}
+
+/*
+Intersects circles i and j of the set. Returns false if the anchors are too
+close, the circles do not meet or one lies inside the other.
+*/
+static inline bool circles_intersection(const struct Anchor_Set *set, int i, int j, struct Coordinates *coord, struct Coordinates *coord_prime)
+{
+    const struct Anchor_Pair *pair;
+    float x2, y2, ux, uy;
+    float a, h;
+    float r1 = set->r[i];
+    float r2 = set->r[j];
+
+    if (set->slot[i] < set->slot[j])
+    {
+        pair = &pair_table[pair_index(set->slot[i], set->slot[j])];
+        ux = pair->ux;
+        uy = pair->uy;
+    }
+    else
+    {
+        pair = &pair_table[pair_index(set->slot[j], set->slot[i])];
+        ux = -pair->ux;
+        uy = -pair->uy;
+    }
+
+    if (!pair->usable || (pair->dist > (r1 + r2)) || (pair->dist < fabsf(r1 - r2)))
+        return false;
+
+    a = (square(r1) - square(r2) + square(pair->dist)) * 0.5f * pair->inv_dist;
+    h = sqrtf(square(r1) - square(a));
+
+    x2 = set->x[i] + ux * a;
+    y2 = set->y[i] + uy * a;
+
+    coord->x = ceilf(x2 + uy * h);
+    coord_prime->x = ceilf(x2 - uy * h);
+
+    coord->y = ceilf(y2 - ux * h);
+    coord_prime->y = ceilf(y2 + ux * h);
+
+    coord->flag = true;
+    coord_prime->flag = true;
+    return true;
+}
+
+/*
+Batched intersection kernel: runs each unordered pair (i < j) once and writes
+both points of every intersecting pair into points. Returns the point count.
+*/
+int pairwise_intersections(const struct Anchor_Set *set, struct Coordinates *points)
+{
+    int count = 0;
+    int i, j;
+
+    for (i = 0; i < set->count - 1; i++)
+    {
+        for (j = i + 1; j < set->count; j++)
+        {
+            if (circles_intersection(set, i, j, &points[count], &points[count + 1]))
+                count += 2;
+        }
+    }
+    return count;
+}
+
+int is_inside_circles(struct Coordinates coords)
+{
+    const struct Anchor_Set *set = &anchor_set;
+    int count = 0;
+    int i;
+
+    for (i = 0; i < set->count; i++)
+    {
+        if (square(coords.x - set->x[i]) + square(coords.y - set->y[i]) <= square(set->r[i] + CIRCLE_TOLERANCE))
+            count++;
+    }
+    return count;
+}
+
+int get_polygon(uint8_t from_Type, uint8_t to_Type, int error, int active_anchors)
+{
+    int count = 0;
+    int circle_count = 0;
+    struct IPs *temp_ip = NULL;
+
+    temp_ip = get_intersections(from_Type);
+    if (temp_ip == NULL)
+        return 0;
+
+    do
+    {
+        circle_count = is_inside_circles(temp_ip->coords);
+        if (circle_count >= (active_anchors - error))
+        {
+            merge_intersection(temp_ip->coords, temp_ip->hits, to_Type);
+            count += temp_ip->hits;
+        }
+        temp_ip = temp_ip->next;
+    } while (temp_ip != NULL);
+    return count;
+}
+
+struct Coordinates get_dev_location(void)
+{
+    struct Coordinates dev_coords = {
+        .flag = false,
+        .x = -1,
+        .y = -1,
+    };
+    int ret;
+    int i, point_count;
+
+    int error_rate = 0;
+    int active_anchors = 0;
+
+    active_anchors = load_anchor_set(&anchor_set);
+    point_count = pairwise_intersections(&anchor_set, pair_points);
+    for (i = 0; i < point_count; i++)
+    {
+        // Points outside the building outline cannot be the device.
+        if (building.count > 0 && !is_inside_building(pair_points[i]))
+            continue;
+        add_intersection(pair_points[i], IPs_LIST1);
+    }
+
+POLYGON_CALC:
+    ret = get_polygon(IPs_LIST1, IPs_LIST2, error_rate, active_anchors);
+
+    if (ret > 2)
+    {
+        dev_coords = get_centroid(IPs_LIST2);
+        remove_all_intersections(IPs_LIST2);
+    }
+    /*
+    else if (ret > 1)
+    {
+        dev_coords = get_centroid(IPs_LIST2);
+        remove_all_intersections(IPs_LIST2);
+    }
+    */
+
+    else
+    {
+        if (error_rate < 1)
+        {
+            error_rate = 1;
+            goto POLYGON_CALC;
+        }
+        remove_all_intersections(IPs_LIST2);
+    }
+
+    remove_all_intersections(IPs_LIST1);
+    return dev_coords;
+}
+
+struct Coordinates get_centroid(uint8_t IPs_Type)
+{
+    struct Coordinates coords = {
+        .flag = false,
+        .x = 0,
+        .y = 0,
+    };
+    struct IPs *temp_ip = NULL;
+    int count = 0;
+
+    temp_ip = get_intersections(IPs_Type);
+
+    do
+    {
+        coords.x += temp_ip->coords.x * temp_ip->hits;
+        coords.y += temp_ip->coords.y * temp_ip->hits;
+
+        count += temp_ip->hits;
+        temp_ip = temp_ip->next;
+    } while (temp_ip != NULL);
+
+    coords.x = (coords.x / count);
+    coords.y = (coords.y / count);
+    coords.flag = true;
+    return coords;
+}
@@ -0,0 +1,216 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Grid search over precomputed per-anchor distance tables.
+ */
+
+#include <localization.h>
+
+#include <math.h>
+#include <stddef.h>
+
+/*
+grid_prepare() lays a LOC_GRID_CELLS x LOC_GRID_CELLS grid over the building
+rectangle and stores the distance from every cell center to every anchor,
+rounded to whole pixels (uint16). A fix sums the weighted squared range
+residuals of all cells anchor by anchor, a straight loop over contiguous tables
+the compiler can vectorize, and takes the cheapest cell inside the building
+outline. GRID_REFINE_LEVELS rounds
+of a 3x3 search with halving steps then refine it with exact distances. The
+cost is N x cells + 9 N x levels whatever the range geometry.
+
+Without building corners the grid covers the anchor bounding box grown by
+GRID_ANCHOR_MARGIN times its larger side on every side, as a tag can stand
+outside the anchors' hull. A best cell on the border of that grid means the
+minimum may lie beyond it, and the fix fails rather than being clamped.
+*/
+#define GRID_CELL_COUNT (LOC_GRID_CELLS * LOC_GRID_CELLS)
+#define GRID_REFINE_LEVELS 6
+#define GRID_ANCHOR_MARGIN 1.0f
+
+struct Grid
+{
+    bool valid;
+    bool open; // Bounds from the anchors, the device may be beyond the border
+    float x0; // Center of cell (0, 0)
+    float y0;
+    float step_x; // Cell pitch in pixels
+    float step_y;
+    uint8_t inside[GRID_CELL_COUNT]; // Cell center inside the building outline
+    uint16_t distance[LOC_MAX_ANCHORS][GRID_CELL_COUNT]; // Pixels, indexed by anchor_pool slot
+};
+
+static struct Grid grid;
+static float grid_cost[GRID_CELL_COUNT];
+
+/*
+Building rectangle from the corners (the bounding box of the outline), or the
+padded anchor bounding box if the master has not sent them.
+*/
+static bool grid_bounds(float *min_x, float *min_y, float *max_x, float *max_y)
+{
+    struct Anchor *temp_anchor = front;
+    float margin;
+
+    grid.open = false;
+    if (bottom_left_corner.flag && top_right_corner.flag)
+    {
+        *min_x = fminf(bottom_left_corner.x, top_right_corner.x);
+        *max_x = fmaxf(bottom_left_corner.x, top_right_corner.x);
+        *min_y = fminf(bottom_left_corner.y, top_right_corner.y);
+        *max_y = fmaxf(bottom_left_corner.y, top_right_corner.y);
+        return (*max_x > *min_x) && (*max_y > *min_y);
+    }
+
+    if (temp_anchor == NULL)
+        return false;
+    *min_x = *max_x = temp_anchor->coords.x;
+    *min_y = *max_y = temp_anchor->coords.y;
+    for (; temp_anchor != NULL; temp_anchor = temp_anchor->next)
+    {
+        *min_x = fminf(*min_x, temp_anchor->coords.x);
+        *max_x = fmaxf(*max_x, temp_anchor->coords.x);
+        *min_y = fminf(*min_y, temp_anchor->coords.y);
+        *max_y = fmaxf(*max_y, temp_anchor->coords.y);
+    }
+    margin = GRID_ANCHOR_MARGIN * fmaxf(*max_x - *min_x, *max_y - *min_y);
+    *min_x -= margin;
+    *max_x += margin;
+    *min_y -= margin;
+    *max_y += margin;
+    grid.open = true;
+    return (*max_x > *min_x) && (*max_y > *min_y);
+}
+
+/*
+Builds the distance tables of the whole anchor queue. Called once the master
+has sent the complete anchor set.
+*/
+void grid_prepare(void)
+{
+    struct Anchor *temp_anchor;
+    struct Coordinates center = {.flag = true};
+    float min_x, min_y, max_x, max_y, d;
+    uint16_t *table;
+    int cx, cy;
+
+    grid.valid = grid_bounds(&min_x, &min_y, &max_x, &max_y);
+    if (!grid.valid)
+        return;
+
+    grid.step_x = (max_x - min_x) / LOC_GRID_CELLS;
+    grid.step_y = (max_y - min_y) / LOC_GRID_CELLS;
+    grid.x0 = min_x + grid.step_x / 2;
+    grid.y0 = min_y + grid.step_y / 2;
+
+    for (cy = 0; cy < LOC_GRID_CELLS; cy++)
+    {
+        for (cx = 0; cx < LOC_GRID_CELLS; cx++)
+        {
+            center.x = grid.x0 + cx * grid.step_x;
+            center.y = grid.y0 + cy * grid.step_y;
+            grid.inside[cy * LOC_GRID_CELLS + cx] = (building.count == 0) || is_inside_building(center);
+        }
+    }
+
+    for (temp_anchor = front; temp_anchor != NULL; temp_anchor = temp_anchor->next)
+    {
+        table = grid.distance[temp_anchor - anchor_pool];
+        for (cy = 0; cy < LOC_GRID_CELLS; cy++)
+        {
+            for (cx = 0; cx < LOC_GRID_CELLS; cx++)
+            {
+                d = hypotf(grid.x0 + cx * grid.step_x - temp_anchor->coords.x,
+                           grid.y0 + cy * grid.step_y - temp_anchor->coords.y);
+                *table++ = (d < UINT16_MAX) ? (uint16_t)(d + 0.5f) : UINT16_MAX;
+            }
+        }
+    }
+}
+
+static float grid_residual(const struct Anchor_Set *set, float x, float y)
+{
+    float cost = 0;
+    float res;
+    int i;
+
+    for (i = 0; i < set->count; i++)
+    {
+        res = hypotf(x - set->x[i], y - set->y[i]) - set->r[i];
+        cost += set->w[i] * res * res;
+    }
+    return cost;
+}
+
+struct Coordinates solve_grid(const struct Anchor_Set *set)
+{
+    struct Coordinates coords = {
+        .flag = false,
+        .x = -1,
+        .y = -1,
+    };
+    const uint16_t *table;
+    float x, y, step_x, step_y, r, w, res, best, cost, best_x, best_y;
+    int c, i, k, level, best_cell;
+
+    if (!grid.valid || set->count < 3)
+        return coords;
+
+    for (c = 0; c < GRID_CELL_COUNT; c++)
+        grid_cost[c] = 0;
+    for (k = 0; k < set->count; k++)
+    {
+        table = grid.distance[set->slot[k]];
+        r = set->r[k];
+        w = set->w[k];
+        for (c = 0; c < GRID_CELL_COUNT; c++)
+        {
+            res = table[c] - r;
+            grid_cost[c] += w * res * res;
+        }
+    }
+
+    best_cell = -1;
+    for (c = 0; c < GRID_CELL_COUNT; c++)
+    {
+        if (grid.inside[c] && (best_cell < 0 || grid_cost[c] < grid_cost[best_cell]))
+            best_cell = c;
+    }
+    if (best_cell < 0)
+        return coords;
+    if (grid.open && (best_cell % LOC_GRID_CELLS == 0 || best_cell % LOC_GRID_CELLS == LOC_GRID_CELLS - 1 ||
+                      best_cell / LOC_GRID_CELLS == 0 || best_cell / LOC_GRID_CELLS == LOC_GRID_CELLS - 1))
+        return coords; // Minimum beyond the padded anchor box
+
+    x = grid.x0 + (best_cell % LOC_GRID_CELLS) * grid.step_x;
+    y = grid.y0 + (best_cell / LOC_GRID_CELLS) * grid.step_y;
+    step_x = grid.step_x;
+    step_y = grid.step_y;
+    best = grid_residual(set, x, y);
+    for (level = 0; level < GRID_REFINE_LEVELS; level++)
+    {
+        step_x = step_x / 2;
+        step_y = step_y / 2;
+        best_x = x;
+        best_y = y;
+        for (i = 0; i < 9; i++)
+        {
+            if (i == 4)
+                continue;
+            cost = grid_residual(set, x + (i % 3 - 1) * step_x, y + (i / 3 - 1) * step_y);
+            if (cost < best)
+            {
+                best = cost;
+                best_x = x + (i % 3 - 1) * step_x;
+                best_y = y + (i / 3 - 1) * step_y;
+            }
+        }
+        x = best_x;
+        y = best_y;
+    }
+
+    coords.x = ceilf(x);
+    coords.y = ceilf(y);
+    coords.flag = true;
+    return coords;
+}
@@ -0,0 +1,198 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Intersection point lists with spatial-hash deduplication.
+ */
+
+#include <localization.h>
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/*
+Every intersection list owns an arena of LOC_MAX_INTERSECTIONS nodes. Nodes are
+handed out in order and the list is released by rewinding the arena.
+
+Duplicates are found through an open-addressing hash keyed on the grid cell
+(LOC_IPS_MERGE_TOLERANCE pixels wide) holding the point. A cell holds at most one
+point, so a lookup probes the cell and its eight neighbours and merges any
+point within the tolerance on both axes. A merged point is not dropped: it
+bumps the hit count of the point it merged into, so callers counting
+candidates still see every intersection. Buckets are stamped with the list's
+epoch + 1 (zeroed memory is empty), so bumping the epoch empties the table
+without touching it.
+*/
+#define IPS_CELL_SIZE (LOC_IPS_MERGE_TOLERANCE > 0 ? LOC_IPS_MERGE_TOLERANCE : 1)
+
+_Static_assert((LOC_IPS_HASH_SIZE & (LOC_IPS_HASH_SIZE - 1)) == 0, "IPs hash size must be a power of two");
+_Static_assert(LOC_IPS_HASH_SIZE > LOC_MAX_INTERSECTIONS, "IPs hash must be larger than the IPs arena");
+_Static_assert(LOC_MAX_INTERSECTIONS <= UINT16_MAX, "IPs arena index must fit a bucket");
+
+struct IPs_Bucket
+{
+    uint16_t stamp;
+    uint16_t index;
+};
+
+struct IPs_Queue
+{
+    struct IPs *front;
+    struct IPs *rear;
+    int used;
+    uint16_t epoch;
+    struct IPs pool[LOC_MAX_INTERSECTIONS];
+    struct IPs_Bucket table[LOC_IPS_HASH_SIZE];
+};
+
+static struct IPs_Queue ips_queues[IPs_LISTS];
+
+static inline uint16_t get_stamp(struct IPs_Queue *queue)
+{
+    return (uint16_t)(queue->epoch + 1);
+}
+
+static int32_t get_cell(float value)
+{
+    return (int32_t)floorf(value / IPS_CELL_SIZE);
+}
+
+static uint32_t hash_cell(int32_t cell_x, int32_t cell_y)
+{
+    return (((uint32_t)cell_x * 73856093u) ^ ((uint32_t)cell_y * 19349663u)) & (LOC_IPS_HASH_SIZE - 1);
+}
+
+static bool near_coordinates(struct Coordinates coord1, struct Coordinates coord2)
+{
+    if ((fabsf(coord1.x - coord2.x) <= LOC_IPS_MERGE_TOLERANCE) && (fabsf(coord1.y - coord2.y) <= LOC_IPS_MERGE_TOLERANCE))
+        return true;
+    else
+        return false;
+}
+
+/*
+Returns the arena index of the point stored in the given cell, or -1.
+*/
+static int find_in_cell(struct IPs_Queue *queue, int32_t cell_x, int32_t cell_y)
+{
+    uint32_t bucket = hash_cell(cell_x, cell_y);
+    struct IPs *temp_ip;
+
+    while (queue->table[bucket].stamp == get_stamp(queue))
+    {
+        temp_ip = &queue->pool[queue->table[bucket].index];
+        if (get_cell(temp_ip->coords.x) == cell_x && get_cell(temp_ip->coords.y) == cell_y)
+            return queue->table[bucket].index;
+        bucket = (bucket + 1) & (LOC_IPS_HASH_SIZE - 1);
+    }
+    return -1;
+}
+
+/*
+Returns the arena index of a stored point within the merge tolerance, or -1.
+*/
+static int find_near(struct IPs_Queue *queue, struct Coordinates coords)
+{
+    int32_t cell_x = get_cell(coords.x);
+    int32_t cell_y = get_cell(coords.y);
+    int32_t i, j;
+    int index;
+
+    for (i = cell_x - 1; i <= cell_x + 1; i++)
+    {
+        for (j = cell_y - 1; j <= cell_y + 1; j++)
+        {
+            index = find_in_cell(queue, i, j);
+            if (index >= 0 && near_coordinates(coords, queue->pool[index].coords))
+                return index;
+        }
+    }
+    return -1;
+}
+
+bool already_existing_intersection(struct Coordinates coords, uint8_t IPs_Type)
+{
+    return find_near(&ips_queues[IPs_Type], coords) >= 0;
+}
+
+static void hash_intersection(struct IPs_Queue *queue, int index)
+{
+    struct IPs *n_ip = &queue->pool[index];
+    uint32_t bucket = hash_cell(get_cell(n_ip->coords.x), get_cell(n_ip->coords.y));
+
+    while (queue->table[bucket].stamp == get_stamp(queue))
+        bucket = (bucket + 1) & (LOC_IPS_HASH_SIZE - 1);
+
+    queue->table[bucket].stamp = get_stamp(queue);
+    queue->table[bucket].index = (uint16_t)index;
+}
+
+/*
+Adds a point standing for hits intersections, or adds its hits to a stored
+point within the merge tolerance.
+*/
+void merge_intersection(struct Coordinates coords, int hits, uint8_t IPs_Type)
+{
+    struct IPs_Queue *queue = &ips_queues[IPs_Type];
+    struct IPs *n_ip;
+    int index;
+
+    index = find_near(queue, coords);
+    if (index >= 0)
+    {
+        queue->pool[index].hits += hits;
+        return;
+    }
+
+    if (queue->used >= LOC_MAX_INTERSECTIONS)
+        return; // Arena full, point dropped.
+
+    n_ip = &queue->pool[queue->used];
+    n_ip->coords = coords;
+    n_ip->hits = hits;
+    n_ip->next = NULL;
+    hash_intersection(queue, queue->used);
+    queue->used++;
+
+    if (queue->rear == NULL)
+    {
+        queue->front = n_ip;
+        queue->rear = n_ip;
+    }
+    else
+    {
+        queue->rear->next = n_ip;
+        queue->rear = n_ip;
+    }
+}
+
+void add_intersection(struct Coordinates coords, uint8_t IPs_Type)
+{
+    merge_intersection(coords, 1, IPs_Type);
+}
+
+struct IPs *get_intersections(uint8_t IPs_Type)
+{
+    return ips_queues[IPs_Type].front;
+}
+
+int get_intersection_count(uint8_t IPs_Type)
+{
+    return ips_queues[IPs_Type].used;
+}
+
+void remove_all_intersections(uint8_t IPs_Type)
+{
+    struct IPs_Queue *queue = &ips_queues[IPs_Type];
+
+    queue->front = NULL;
+    queue->rear = NULL;
+    queue->used = 0;
+    queue->epoch++;
+    if (get_stamp(queue) == 0)
+    {
+        // Stamp wrapped, stale buckets could look valid again.
+        memset(queue->table, 0, sizeof(queue->table));
+        queue->epoch = 0;
+    }
+}
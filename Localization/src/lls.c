@@ -0,0 +1,155 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Closed-form linear least-squares trilateration.
+ */
+
+#include <localization.h>
+
+#include <math.h>
+#include <stddef.h>
+
+/*
+Subtracting the mean of the circle equations x^2 + y^2 - 2 xi x - 2 yi y + ki = ri^2
+(ki = xi^2 + yi^2) gives the linear system A p = b with rows ai = 2 (xi - xm, yi - ym)
+and bi = (ki - km) - (ri^2 - rm^2). With Gi = (A^T A)^-1 ai the Gi sum to zero, so the
+means drop out and p = sum Gi (ki - ri^2) = c - sum Gi ri^2.
+
+Gi and c depend on anchor positions only. lls_prepare() computes them once per anchor
+set, leaving one multiply-add per anchor and axis for each fix.
+*/
+struct LLS_Cache
+{
+    bool valid;
+    int count; // Anchors covered by the factorization
+    float gx[LOC_MAX_ANCHORS]; // Gi, indexed by anchor_pool slot
+    float gy[LOC_MAX_ANCHORS];
+    float cx;
+    float cy;
+};
+
+static struct LLS_Cache lls_cache;
+
+/*
+Factorizes the centered anchor matrix of n anchors. Returns false if the
+anchors are collinear.
+*/
+static bool lls_factorize(const float *x, const float *y, int n, float *gx, float *gy, float *cx, float *cy)
+{
+    float xm = 0, ym = 0, sxx = 0, sxy = 0, syy = 0;
+    float ax, ay, det, k;
+    int i;
+
+    if (n < 3)
+        return false;
+
+    for (i = 0; i < n; i++)
+    {
+        xm += x[i];
+        ym += y[i];
+    }
+    xm = xm / n;
+    ym = ym / n;
+
+    for (i = 0; i < n; i++)
+    {
+        ax = 2 * (x[i] - xm);
+        ay = 2 * (y[i] - ym);
+        sxx += ax * ax;
+        sxy += ax * ay;
+        syy += ay * ay;
+    }
+    det = sxx * syy - sxy * sxy;
+    if (det <= 0)
+        return false;
+
+    *cx = 0;
+    *cy = 0;
+    for (i = 0; i < n; i++)
+    {
+        ax = 2 * (x[i] - xm);
+        ay = 2 * (y[i] - ym);
+        gx[i] = (syy * ax - sxy * ay) / det;
+        gy[i] = (sxx * ay - sxy * ax) / det;
+        k = square(x[i]) + square(y[i]);
+        *cx += gx[i] * k;
+        *cy += gy[i] * k;
+    }
+    return true;
+}
+
+/*
+Caches the factorization of the whole anchor queue. Called once the master has
+sent the complete anchor set.
+*/
+void lls_prepare(void)
+{
+    static float x[LOC_MAX_ANCHORS], y[LOC_MAX_ANCHORS], gx[LOC_MAX_ANCHORS], gy[LOC_MAX_ANCHORS];
+    static int slot[LOC_MAX_ANCHORS];
+    struct Anchor *temp_anchor = front;
+    int n = 0;
+    int i;
+
+    while (temp_anchor != NULL)
+    {
+        slot[n] = temp_anchor - anchor_pool;
+        x[n] = temp_anchor->coords.x;
+        y[n] = temp_anchor->coords.y;
+        n++;
+        temp_anchor = temp_anchor->next;
+    }
+
+    lls_cache.valid = lls_factorize(x, y, n, gx, gy, &lls_cache.cx, &lls_cache.cy);
+    lls_cache.count = n;
+    for (i = 0; lls_cache.valid && i < n; i++)
+    {
+        lls_cache.gx[slot[i]] = gx[i];
+        lls_cache.gy[slot[i]] = gy[i];
+    }
+}
+
+/*
+Uses the cached factorization when every anchor has a range, otherwise
+factorizes the active subset on the spot (still O(N)). The per-anchor scratch
+is static, like in lls_prepare(), so the solver thread stack does not grow
+with LOC_MAX_ANCHORS.
+*/
+struct Coordinates solve_lls(const struct Anchor_Set *set)
+{
+    struct Coordinates coords = {
+        .flag = false,
+        .x = -1,
+        .y = -1,
+    };
+    static float gx[LOC_MAX_ANCHORS], gy[LOC_MAX_ANCHORS];
+    float x, y, r2;
+    int i;
+
+    if (lls_cache.valid && set->count == lls_cache.count)
+    {
+        x = lls_cache.cx;
+        y = lls_cache.cy;
+        for (i = 0; i < set->count; i++)
+        {
+            r2 = square(set->r[i]);
+            x -= lls_cache.gx[set->slot[i]] * r2;
+            y -= lls_cache.gy[set->slot[i]] * r2;
+        }
+    }
+    else
+    {
+        if (!lls_factorize(set->x, set->y, set->count, gx, gy, &x, &y))
+            return coords;
+        for (i = 0; i < set->count; i++)
+        {
+            r2 = square(set->r[i]);
+            x -= gx[i] * r2;
+            y -= gy[i] * r2;
+        }
+    }
+
+    coords.x = ceilf(x);
+    coords.y = ceilf(y);
+    coords.flag = true;
+    return coords;
+}
@@ -0,0 +1,206 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Solver selection. solver_engine picks the solver at runtime, its boot value
+ * follows the LOCALIZATION_SOLVER Kconfig choice.
+ */
+
+#include <localization.h>
+
+#include <string.h>
+
+#if defined(CONFIG_LOCALIZATION_SOLVER_NLLS)
+uint8_t solver_engine = SOLVER_NLLS;
+#elif defined(CONFIG_LOCALIZATION_SOLVER_LLS)
+uint8_t solver_engine = SOLVER_LLS;
+#elif defined(CONFIG_LOCALIZATION_SOLVER_PARTICLE)
+uint8_t solver_engine = SOLVER_PARTICLE;
+#elif defined(CONFIG_LOCALIZATION_SOLVER_GRID)
+uint8_t solver_engine = SOLVER_GRID;
+#elif defined(CONFIG_LOCALIZATION_SOLVER_RANSAC)
+uint8_t solver_engine = SOLVER_RANSAC;
+#else
+uint8_t solver_engine = SOLVER_POLYGON;
+#endif
+
+const char *const solver_names[SOLVER_COUNT] = {
+    [SOLVER_POLYGON] = "polygon",
+    [SOLVER_NLLS] = "nlls",
+    [SOLVER_LLS] = "lls",
+    [SOLVER_PARTICLE] = "particle",
+    [SOLVER_GRID] = "grid",
+    [SOLVER_RANSAC] = "ransac",
+};
+
+#if defined(CONFIG_LOCALIZATION_TIERED)
+bool tiered_solving = true;
+#else
+bool tiered_solving = false;
+#endif
+float tier_threshold = LOC_TIER_THRESHOLD; // Pixels, weighted RMS range residual
+uint8_t fix_tier = FIX_TIER_FULL;          // Tier of the last fix
+uint32_t tier_count[FIX_TIERS];
+
+const char *const tier_names[FIX_TIERS] = {
+    [FIX_TIER_MINMAX] = "minmax",
+    [FIX_TIER_PREVIOUS] = "previous",
+    [FIX_TIER_FULL] = "full",
+};
+
+struct Coordinates last_fix = {
+    .flag = false,
+    .x = -1,
+    .y = -1,
+};
+
+/*
+Tells whether the solver is compiled in. An engine that is not runs as
+SOLVER_POLYGON.
+*/
+bool solver_built(uint8_t engine)
+{
+    if (engine == SOLVER_GRID)
+        return LOC_SOLVER_GRID;
+    if (engine == SOLVER_PARTICLE)
+        return LOC_SOLVER_PARTICLE;
+    return engine < SOLVER_COUNT;
+}
+
+/*
+Returns the solver id for a name of solver_names, or -1 if there is no such
+solver or it is not compiled in.
+*/
+int find_solver(const char *name)
+{
+    int i;
+
+    for (i = 0; i < SOLVER_COUNT; i++)
+    {
+        if (strcmp(name, solver_names[i]) == 0)
+            return solver_built((uint8_t)i) ? i : -1;
+    }
+    return -1;
+}
+
+/*
+Precomputes what the solvers need from the anchor geometry. Called once the
+master has sent the complete anchor set.
+*/
+void locate_prepare(void)
+{
+    pair_prepare();
+    lls_prepare();
+#if LOC_SOLVER_GRID
+    grid_prepare();
+#endif
+}
+
+/*
+Runs the selected solver on the current anchor ranges. HEIGHT_3D replaces the
+2D solvers with the 3D multilateration, which also sets device_height.
+*/
+static struct Coordinates locate_full(void)
+{
+    struct Coordinates dev_coords = {
+        .flag = false,
+        .x = -1,
+        .y = -1,
+    };
+
+    if (height_mode == HEIGHT_3D)
+    {
+        load_anchor_set(&anchor_set);
+        dev_coords = solve_nlls3d(&anchor_set, last_fix, &device_height);
+    }
+    else if (solver_engine == SOLVER_NLLS)
+    {
+        load_anchor_set(&anchor_set);
+        if (solve_nlls(&anchor_set, last_fix, &nlls_result))
+            dev_coords = nlls_result.coords;
+    }
+    else if (solver_engine == SOLVER_LLS)
+    {
+        load_anchor_set(&anchor_set);
+        dev_coords = solve_lls(&anchor_set);
+    }
+#if LOC_SOLVER_PARTICLE
+    else if (solver_engine == SOLVER_PARTICLE)
+    {
+        load_anchor_set(&anchor_set);
+        dev_coords = solve_particle(&anchor_set);
+    }
+#endif
+#if LOC_SOLVER_GRID
+    else if (solver_engine == SOLVER_GRID)
+    {
+        load_anchor_set(&anchor_set);
+        dev_coords = solve_grid(&anchor_set);
+    }
+#endif
+    else if (solver_engine == SOLVER_RANSAC)
+    {
+        load_anchor_set(&anchor_set);
+        dev_coords = solve_ransac(&anchor_set);
+    }
+    else
+    {
+        dev_coords = get_dev_location();
+    }
+    return dev_coords;
+}
+
+/*
+Cheap tiers: the min-max estimate and the previous fix, O(N) each. The one
+whose weighted RMS range residual is lower is taken if that residual is within
+tier_threshold, so a tag standing still keeps its fix without running the
+solver. Returns false when the full solver has to run.
+*/
+static bool locate_cheap(struct Coordinates *dev_coords)
+{
+    struct Coordinates estimate;
+    float residual, previous;
+
+    if (load_anchor_set(&anchor_set) < 3)
+        return false;
+
+    estimate = solve_minmax(&anchor_set);
+    residual = range_residual(&anchor_set, estimate.x, estimate.y);
+    fix_tier = FIX_TIER_MINMAX;
+    if (last_fix.flag)
+    {
+        previous = range_residual(&anchor_set, last_fix.x, last_fix.y);
+        if (previous <= residual)
+        {
+            estimate = last_fix;
+            residual = previous;
+            fix_tier = FIX_TIER_PREVIOUS;
+        }
+    }
+    if (residual > tier_threshold)
+        return false;
+    *dev_coords = estimate;
+    return true;
+}
+
+/*
+Locates the device and remembers the fix for the next warm start. With
+tiered_solving the cheap tiers are tried first (not in HEIGHT_3D, which has to
+solve the height). fix_tier and tier_count tell which tier gave the fix.
+*/
+struct Coordinates locate_device(void)
+{
+    struct Coordinates dev_coords;
+
+    if (!tiered_solving || height_mode == HEIGHT_3D || !locate_cheap(&dev_coords))
+    {
+        dev_coords = locate_full();
+        fix_tier = FIX_TIER_FULL;
+    }
+
+    if (dev_coords.flag)
+    {
+        last_fix = dev_coords;
+        tier_count[fix_tier]++;
+    }
+    return dev_coords;
+}
@@ -0,0 +1,66 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Min-max (bounding box) estimate and range residual, the cheap tiers of
+ * locate_device().
+ */
+
+#include <localization.h>
+
+#include <math.h>
+
+/*
+Every range r_i bounds the device to the square [x_i - r_i, x_i + r_i] x
+[y_i - r_i, y_i + r_i]; the estimate is the center of the intersection of all
+squares. One O(N) pass with no square roots. Ranges that are too short leave
+an empty intersection, whose center is still the best guess between the
+conflicting bounds.
+*/
+struct Coordinates solve_minmax(const struct Anchor_Set *set)
+{
+    struct Coordinates coords = {
+        .flag = false,
+        .x = -1,
+        .y = -1,
+    };
+    float min_x = -INFINITY, max_x = INFINITY;
+    float min_y = -INFINITY, max_y = INFINITY;
+    int i;
+
+    if (set->count < 3)
+        return coords;
+
+    for (i = 0; i < set->count; i++)
+    {
+        min_x = fmaxf(min_x, set->x[i] - set->r[i]);
+        max_x = fminf(max_x, set->x[i] + set->r[i]);
+        min_y = fmaxf(min_y, set->y[i] - set->r[i]);
+        max_y = fminf(max_y, set->y[i] + set->r[i]);
+    }
+
+    coords.x = ceilf((min_x + max_x) / 2);
+    coords.y = ceilf((min_y + max_y) / 2);
+    coords.flag = true;
+    return coords;
+}
+
+/*
+Weighted RMS of the range residuals |p - anchor_i| - r_i at (x, y), in pixels.
+*/
+float range_residual(const struct Anchor_Set *set, float x, float y)
+{
+    float cost = 0;
+    float weight = 0;
+    float res;
+    int i;
+
+    for (i = 0; i < set->count; i++)
+    {
+        res = hypotf(x - set->x[i], y - set->y[i]) - set->r[i];
+        cost += set->w[i] * res * res;
+        weight += set->w[i];
+    }
+    if (weight <= 0)
+        return INFINITY;
+    return sqrtf(cost / weight);
+}
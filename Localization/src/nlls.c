@@ -0,0 +1,140 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Levenberg-Marquardt multilateration on the anchor ranges.
+ */
+
+#include <localization.h>
+
+#include <math.h>
+
+/*
+Levenberg-Marquardt on the range residuals |p - anchor_i| - r_i, weighted by
+the range weights w_i of the set. Every iteration is one O(N) pass building the
+2x2 normal equations. The solver is
+warm-started from the previous fix and stops after LOC_NLLS_MAX_ITERATIONS or once
+the step falls below NLLS_STEP_LIMIT pixels.
+*/
+#define NLLS_STEP_LIMIT 0.5f
+#define NLLS_LAMBDA_INIT 0.001f
+#define NLLS_MIN_DIST 1.0f
+
+struct NLLS_Result nlls_result;
+
+/*
+Accumulates J^T W J, J^T W f and the weighted squared residual sum at (x, y).
+*/
+static float nlls_normal_equations(const struct Anchor_Set *set, float x, float y, float *jtj, float *jtf)
+{
+    float cost = 0;
+    float dx, dy, dist, res, ux, uy, w;
+    int i;
+
+    jtj[0] = jtj[1] = jtj[2] = 0;
+    jtf[0] = jtf[1] = 0;
+
+    for (i = 0; i < set->count; i++)
+    {
+        dx = x - set->x[i];
+        dy = y - set->y[i];
+        dist = hypotf(dx, dy);
+        if (dist < NLLS_MIN_DIST)
+            dist = NLLS_MIN_DIST;
+        res = dist - set->r[i];
+        w = set->w[i];
+        ux = dx / dist;
+        uy = dy / dist;
+
+        jtj[0] += w * ux * ux;
+        jtj[1] += w * ux * uy;
+        jtj[2] += w * uy * uy;
+        jtf[0] += w * ux * res;
+        jtf[1] += w * uy * res;
+        cost += w * res * res;
+    }
+    return cost;
+}
+
+bool solve_nlls(const struct Anchor_Set *set, struct Coordinates start, struct NLLS_Result *result)
+{
+    float jtj[3], jtf[2];
+    float x, y, cost, new_cost, det, a, b, c, step_x, step_y, sigma2;
+    float lambda = NLLS_LAMBDA_INIT;
+    float new_jtj[3], new_jtf[2];
+    int i, iter;
+
+    result->coords.flag = false;
+    if (set->count < 3)
+        return false;
+
+    if (start.flag)
+    {
+        x = start.x;
+        y = start.y;
+    }
+    else
+    {
+        x = 0;
+        y = 0;
+        for (i = 0; i < set->count; i++)
+        {
+            x += set->x[i];
+            y += set->y[i];
+        }
+        x = x / set->count;
+        y = y / set->count;
+    }
+
+    cost = nlls_normal_equations(set, x, y, jtj, jtf);
+    for (iter = 0; iter < LOC_NLLS_MAX_ITERATIONS; iter++)
+    {
+        a = jtj[0] * (1 + lambda);
+        b = jtj[1];
+        c = jtj[2] * (1 + lambda);
+        det = a * c - b * b;
+        if (det <= 0)
+            break;
+
+        step_x = -(c * jtf[0] - b * jtf[1]) / det;
+        step_y = -(a * jtf[1] - b * jtf[0]) / det;
+
+        new_cost = nlls_normal_equations(set, x + step_x, y + step_y, new_jtj, new_jtf);
+        if (new_cost < cost)
+        {
+            x += step_x;
+            y += step_y;
+            cost = new_cost;
+            jtj[0] = new_jtj[0];
+            jtj[1] = new_jtj[1];
+            jtj[2] = new_jtj[2];
+            jtf[0] = new_jtf[0];
+            jtf[1] = new_jtf[1];
+            lambda = lambda / 10;
+            if (fabsf(step_x) < NLLS_STEP_LIMIT && fabsf(step_y) < NLLS_STEP_LIMIT)
+            {
+                iter++;
+                break;
+            }
+        }
+        else
+        {
+            lambda = lambda * 10;
+        }
+    }
+
+    det = jtj[0] * jtj[2] - jtj[1] * jtj[1];
+    if (det <= 0)
+        return false;
+
+    // Residual variance scales (J^T J)^-1 into a position covariance.
+    sigma2 = (set->count > 2) ? cost / (set->count - 2) : cost;
+    result->cov_xx = sigma2 * jtj[2] / det;
+    result->cov_xy = -sigma2 * jtj[1] / det;
+    result->cov_yy = sigma2 * jtj[0] / det;
+    result->iterations = iter;
+
+    result->coords.x = ceilf(x);
+    result->coords.y = ceilf(y);
+    result->coords.flag = true;
+    return true;
+}
@@ -0,0 +1,166 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Levenberg-Marquardt sphere multilateration in three dimensions.
+ */
+
+#include <localization.h>
+
+#include <math.h>
+
+/*
+Same scheme as solve_nlls with the height z as a third unknown and the slant
+ranges |p - anchor_i| - r_i as residuals. Anchors mounted at one common height
+leave z unobservable up to a mirror image, so a weak prior
+NLLS3D_HEIGHT_WEIGHT (z - tag_height)^2 holds it near the known tag height
+unless the anchor heights say otherwise. One O(N) pass per iteration builds
+the 3x3 normal equations, solved by Cramer's rule.
+*/
+#define NLLS3D_STEP_LIMIT 0.5f
+#define NLLS3D_LAMBDA_INIT 0.001f
+#define NLLS3D_MIN_DIST 1.0f
+#define NLLS3D_HEIGHT_WEIGHT 0.05f // Relative to a range of weight 1
+
+float device_height = -1;
+
+/*
+Accumulates J^T W J (upper triangle xx, xy, xz, yy, yz, zz), J^T W f and the
+weighted cost at (x, y, z), the height prior included.
+*/
+static float nlls3d_normal_equations(const struct Anchor_Set *set, const float *p, float *jtj, float *jtf)
+{
+    float dz_prior = p[2] - tag_height;
+    float cost = NLLS3D_HEIGHT_WEIGHT * dz_prior * dz_prior;
+    float d[3], u[3];
+    float dist, res, w;
+    int i, k;
+
+    for (k = 0; k < 6; k++)
+        jtj[k] = 0;
+    jtf[0] = jtf[1] = 0;
+    jtj[5] = NLLS3D_HEIGHT_WEIGHT;
+    jtf[2] = NLLS3D_HEIGHT_WEIGHT * dz_prior;
+
+    for (i = 0; i < set->count; i++)
+    {
+        d[0] = p[0] - set->x[i];
+        d[1] = p[1] - set->y[i];
+        d[2] = p[2] - set->z[i];
+        dist = sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        if (dist < NLLS3D_MIN_DIST)
+            dist = NLLS3D_MIN_DIST;
+        res = dist - set->r[i];
+        w = set->w[i];
+        for (k = 0; k < 3; k++)
+            u[k] = d[k] / dist;
+
+        jtj[0] += w * u[0] * u[0];
+        jtj[1] += w * u[0] * u[1];
+        jtj[2] += w * u[0] * u[2];
+        jtj[3] += w * u[1] * u[1];
+        jtj[4] += w * u[1] * u[2];
+        jtj[5] += w * u[2] * u[2];
+        for (k = 0; k < 3; k++)
+            jtf[k] += w * u[k] * res;
+        cost += w * res * res;
+    }
+    return cost;
+}
+
+/*
+Solves the damped system (J^T W J + lambda diag) step = -J^T W f. Returns
+false if it is singular.
+*/
+static bool nlls3d_step(const float *jtj, const float *jtf, float lambda, float *step)
+{
+    float a = jtj[0] * (1 + lambda), b = jtj[1], c = jtj[2];
+    float e = jtj[3] * (1 + lambda), f = jtj[4];
+    float i = jtj[5] * (1 + lambda);
+    // Cofactors of the symmetric matrix [a b c; b e f; c f i].
+    float c00 = e * i - f * f;
+    float c01 = c * f - b * i;
+    float c02 = b * f - c * e;
+    float c11 = a * i - c * c;
+    float c12 = b * c - a * f;
+    float c22 = a * e - b * b;
+    float det = a * c00 + b * c01 + c * c02;
+
+    if (det <= 0)
+        return false;
+    step[0] = -(c00 * jtf[0] + c01 * jtf[1] + c02 * jtf[2]) / det;
+    step[1] = -(c01 * jtf[0] + c11 * jtf[1] + c12 * jtf[2]) / det;
+    step[2] = -(c02 * jtf[0] + c12 * jtf[1] + c22 * jtf[2]) / det;
+    return true;
+}
+
+struct Coordinates solve_nlls3d(const struct Anchor_Set *set, struct Coordinates start, float *z)
+{
+    struct Coordinates coords = {
+        .flag = false,
+        .x = -1,
+        .y = -1,
+    };
+    float p[3], trial[3], step[3];
+    float jtj[6], jtf[3], new_jtj[6], new_jtf[3];
+    float cost, new_cost;
+    float lambda = NLLS3D_LAMBDA_INIT;
+    int i, k, iter;
+
+    if (set->count < 3)
+        return coords;
+
+    if (start.flag)
+    {
+        p[0] = start.x;
+        p[1] = start.y;
+    }
+    else
+    {
+        p[0] = 0;
+        p[1] = 0;
+        for (i = 0; i < set->count; i++)
+        {
+            p[0] += set->x[i];
+            p[1] += set->y[i];
+        }
+        p[0] = p[0] / set->count;
+        p[1] = p[1] / set->count;
+    }
+    p[2] = tag_height;
+
+    cost = nlls3d_normal_equations(set, p, jtj, jtf);
+    for (iter = 0; iter < LOC_NLLS_MAX_ITERATIONS; iter++)
+    {
+        if (!nlls3d_step(jtj, jtf, lambda, step))
+            break;
+        for (k = 0; k < 3; k++)
+            trial[k] = p[k] + step[k];
+
+        new_cost = nlls3d_normal_equations(set, trial, new_jtj, new_jtf);
+        if (new_cost < cost)
+        {
+            for (k = 0; k < 3; k++)
+            {
+                p[k] = trial[k];
+                jtf[k] = new_jtf[k];
+            }
+            for (k = 0; k < 6; k++)
+                jtj[k] = new_jtj[k];
+            cost = new_cost;
+            lambda = lambda / 10;
+            if (fabsf(step[0]) < NLLS3D_STEP_LIMIT && fabsf(step[1]) < NLLS3D_STEP_LIMIT &&
+                fabsf(step[2]) < NLLS3D_STEP_LIMIT)
+                break;
+        }
+        else
+        {
+            lambda = lambda * 10;
+        }
+    }
+
+    coords.x = ceilf(p[0]);
+    coords.y = ceilf(p[1]);
+    coords.flag = true;
+    *z = p[2];
+    return coords;
+}
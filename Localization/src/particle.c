@@ -0,0 +1,274 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Particle filter constrained by the occupancy map of the floor plan.
+ */
+
+#include <localization.h>
+#include <floor_plan.h>
+
+#include <math.h>
+
+/*
+LOC_PARTICLES position hypotheses live in fixed arrays. Every cycle each
+particle takes a Gaussian step of PARTICLE_MOTION_SIGMA pixels; a step that
+would cross a wall of the floor plan is not taken. Particles are weighted by
+the Gaussian likelihood of the anchor ranges and resampled (systematic) once
+the effective particle count drops below half.
+
+If even the best particle misses the ranges by more than PARTICLE_RESET_SIGMAS
+standard deviations, the filter has lost the device: the particles are thrown
+again around the linear least squares fix, or over the whole free floor plan
+if there is none.
+*/
+#define PARTICLE_MOTION_SIGMA ((float)LOC_PARTICLE_MOTION_SIGMA)
+#define PARTICLE_RANGE_SIGMA ((float)LOC_PARTICLE_RANGE_SIGMA)
+#define PARTICLE_RESET_SIGMAS 3.0f
+#define PARTICLE_SEED 0x2545F491u
+#define PARTICLE_PLACE_TRIES 8
+
+struct Particles
+{
+    bool started;
+    uint32_t rng;
+    float x[LOC_PARTICLES];
+    float y[LOC_PARTICLES];
+    float weight[LOC_PARTICLES]; // Carried over between cycles until resampled
+    float score[LOC_PARTICLES];  // Log likelihood of the current ranges
+    float next_x[LOC_PARTICLES]; // Resampling target
+    float next_y[LOC_PARTICLES];
+};
+
+static struct Particles particles = {.started = false, .rng = PARTICLE_SEED};
+
+static uint32_t particle_rand(void)
+{
+    // xorshift32, the replay of a capture is deterministic
+    particles.rng ^= particles.rng << 13;
+    particles.rng ^= particles.rng >> 17;
+    particles.rng ^= particles.rng << 5;
+    return particles.rng;
+}
+
+static float particle_uniform(void)
+{
+    return (particle_rand() >> 8) * (1.0f / 16777216.0f);
+}
+
+static float particle_gauss(void)
+{
+    float u1 = particle_uniform() + 1e-7f;
+    float u2 = particle_uniform();
+    return sqrtf(-2.0f * logf(u1)) * cosf(6.2831853f * u2);
+}
+
+bool is_free_space(float x, float y)
+{
+    int column, row;
+
+    if (x < 0 || y < 0)
+        return false;
+    column = (int)(x / FLOOR_PLAN_CELL_SIZE);
+    row = (int)(y / FLOOR_PLAN_CELL_SIZE);
+    if (column >= FLOOR_PLAN_COLUMNS || row >= FLOOR_PLAN_ROWS)
+        return false;
+    return (floor_plan_cells[row * FLOOR_PLAN_ROW_BYTES + (column >> 3)] & (1u << (column & 7))) == 0;
+}
+
+/*
+Walks the segment in steps of at most one cell and reports whether it stays
+in free space.
+*/
+static bool free_path(float x0, float y0, float x1, float y1)
+{
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float length = fabsf(dx) > fabsf(dy) ? fabsf(dx) : fabsf(dy);
+    int steps = (int)(length / FLOOR_PLAN_CELL_SIZE) + 1;
+    int i;
+
+    for (i = 1; i <= steps; i++)
+    {
+        if (!is_free_space(x0 + dx * i / steps, y0 + dy * i / steps))
+            return false;
+    }
+    return true;
+}
+
+/*
+Throws every particle around (x, y) with the given spread, or uniformly over
+the floor plan if spread is 0. Positions in walls are retried a few times and
+fall back to the center.
+*/
+static void particles_place(float x, float y, float spread)
+{
+    float px, py;
+    int i, tries;
+
+    for (i = 0; i < LOC_PARTICLES; i++)
+    {
+        for (tries = 0; tries < PARTICLE_PLACE_TRIES; tries++)
+        {
+            if (spread > 0)
+            {
+                px = x + spread * particle_gauss();
+                py = y + spread * particle_gauss();
+            }
+            else
+            {
+                px = particle_uniform() * FLOOR_PLAN_COLUMNS * FLOOR_PLAN_CELL_SIZE;
+                py = particle_uniform() * FLOOR_PLAN_ROWS * FLOOR_PLAN_CELL_SIZE;
+            }
+            if (is_free_space(px, py))
+                break;
+        }
+        if (tries == PARTICLE_PLACE_TRIES)
+        {
+            px = x;
+            py = y;
+        }
+        particles.x[i] = px;
+        particles.y[i] = py;
+        particles.weight[i] = 1.0f;
+    }
+    particles.started = true;
+}
+
+/*
+Log likelihood of the ranges of the set at every particle. Returns the best
+(largest) one.
+*/
+static float particles_weigh(const struct Anchor_Set *set)
+{
+    float scale = -0.5f / (PARTICLE_RANGE_SIGMA * PARTICLE_RANGE_SIGMA);
+    float best = -INFINITY;
+    float res, log_weight;
+    int i, k;
+
+    for (i = 0; i < LOC_PARTICLES; i++)
+    {
+        log_weight = 0;
+        for (k = 0; k < set->count; k++)
+        {
+            res = hypotf(particles.x[i] - set->x[k], particles.y[i] - set->y[k]) - set->r[k];
+            log_weight += res * res;
+        }
+        log_weight = log_weight * scale;
+        particles.score[i] = log_weight;
+        if (log_weight > best)
+            best = log_weight;
+    }
+    return best;
+}
+
+/*
+Systematic resampling of the normalized weights into next_x/next_y, then
+copied back.
+*/
+static void particles_resample(void)
+{
+    float step = 1.0f / LOC_PARTICLES;
+    float target = particle_uniform() * step;
+    float cumulative = particles.weight[0];
+    int i, j = 0;
+
+    for (i = 0; i < LOC_PARTICLES; i++)
+    {
+        while (target > cumulative && j < LOC_PARTICLES - 1)
+            cumulative += particles.weight[++j];
+        particles.next_x[i] = particles.x[j];
+        particles.next_y[i] = particles.y[j];
+        target += step;
+    }
+    for (i = 0; i < LOC_PARTICLES; i++)
+    {
+        particles.x[i] = particles.next_x[i];
+        particles.y[i] = particles.next_y[i];
+        particles.weight[i] = 1.0f;
+    }
+}
+
+void particle_reset(void)
+{
+    particles.started = false;
+    particles.rng = PARTICLE_SEED;
+}
+
+struct Coordinates solve_particle(const struct Anchor_Set *set)
+{
+    struct Coordinates coords = {
+        .flag = false,
+        .x = -1,
+        .y = -1,
+    };
+    struct Coordinates seed;
+    float reset_limit = -0.5f * PARTICLE_RESET_SIGMAS * PARTICLE_RESET_SIGMAS;
+    float px, py, best, total, total_sq, sum_x, sum_y;
+    int i;
+
+    if (set->count < 3)
+        return coords;
+
+    if (particles.started)
+    {
+        for (i = 0; i < LOC_PARTICLES; i++)
+        {
+            px = particles.x[i] + PARTICLE_MOTION_SIGMA * particle_gauss();
+            py = particles.y[i] + PARTICLE_MOTION_SIGMA * particle_gauss();
+            if (free_path(particles.x[i], particles.y[i], px, py))
+            {
+                particles.x[i] = px;
+                particles.y[i] = py;
+            }
+        }
+    }
+
+    // Lost (or not started): restart around the closed-form fix.
+    best = particles.started ? particles_weigh(set) : -INFINITY;
+    if (best < reset_limit * set->count)
+    {
+        seed = solve_lls(set);
+        if (seed.flag)
+            particles_place(seed.x, seed.y, PARTICLE_RANGE_SIGMA);
+        else
+            particles_place(0, 0, 0);
+        best = particles_weigh(set);
+    }
+
+    total = 0;
+    for (i = 0; i < LOC_PARTICLES; i++)
+    {
+        particles.weight[i] = particles.weight[i] * expf(particles.score[i] - best);
+        total += particles.weight[i];
+    }
+    // The carried weights and the new likelihood disagree everywhere.
+    if (total <= 0)
+    {
+        total = 0;
+        for (i = 0; i < LOC_PARTICLES; i++)
+        {
+            particles.weight[i] = expf(particles.score[i] - best);
+            total += particles.weight[i];
+        }
+    }
+
+    total_sq = 0;
+    sum_x = 0;
+    sum_y = 0;
+    for (i = 0; i < LOC_PARTICLES; i++)
+    {
+        particles.weight[i] = particles.weight[i] / total;
+        total_sq += particles.weight[i] * particles.weight[i];
+        sum_x += particles.weight[i] * particles.x[i];
+        sum_y += particles.weight[i] * particles.y[i];
+    }
+
+    coords.x = ceilf(sum_x);
+    coords.y = ceilf(sum_y);
+    coords.flag = true;
+
+    // Effective particle count 1 / total_sq below half the particles.
+    if (total_sq * (LOC_PARTICLES / 2) > 1.0f)
+        particles_resample();
+    return coords;
+}
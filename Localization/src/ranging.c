@@ -0,0 +1,261 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Reduction of the raw ranging samples of one anchor to the range used by the
+ * solvers. Shared by the firmware and the trace replay so both produce the
+ * same ranges from the same samples.
+ */
+
+#include <localization.h>
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/*
+The valid samples of an anchor are reduced to one range by range_estimator:
+
+RANGE_MEAN    plain average (spread: standard deviation)
+RANGE_MEDIAN  median (spread: 1.4826 MAD, the normal-consistent MAD)
+RANGE_MAD     average of the samples within RANGE_MAD_CUTOFF MADs of the
+              median, at least RANGE_MAD_FLOOR centimeters (spread: standard
+              deviation of the kept samples)
+RANGE_TRIMMED average after dropping RANGE_TRIM_PERCENT of the samples at
+              each end (spread: standard deviation of the kept samples)
+*/
+#define RANGE_MAD_SCALE 1.4826f
+#define RANGE_MAD_CUTOFF 3.0f
+#define RANGE_MAD_FLOOR 10.0f
+#define RANGE_TRIM_PERCENT 20
+
+#if defined(CONFIG_LOCALIZATION_RANGE_MEDIAN)
+uint8_t range_estimator = RANGE_MEDIAN;
+#elif defined(CONFIG_LOCALIZATION_RANGE_MAD)
+uint8_t range_estimator = RANGE_MAD;
+#elif defined(CONFIG_LOCALIZATION_RANGE_TRIMMED)
+uint8_t range_estimator = RANGE_TRIMMED;
+#else
+uint8_t range_estimator = RANGE_MEAN;
+#endif
+
+#if defined(CONFIG_LOCALIZATION_HEIGHT_PROJECTED)
+uint8_t height_mode = HEIGHT_PROJECTED;
+#elif defined(CONFIG_LOCALIZATION_HEIGHT_3D)
+uint8_t height_mode = HEIGHT_3D;
+#else
+uint8_t height_mode = HEIGHT_FLAT;
+#endif
+float tag_height = LOC_TAG_HEIGHT; // Map pixels above the floor
+
+const char *const estimator_names[RANGE_ESTIMATORS] = {
+    [RANGE_MEAN] = "mean",
+    [RANGE_MEDIAN] = "median",
+    [RANGE_MAD] = "mad",
+    [RANGE_TRIMMED] = "trimmed",
+};
+
+/*
+Returns the estimator id for a name of estimator_names, or -1.
+*/
+int find_estimator(const char *name)
+{
+    int i;
+
+    for (i = 0; i < RANGE_ESTIMATORS; i++)
+    {
+        if (strcmp(name, estimator_names[i]) == 0)
+            return i;
+    }
+    return -1;
+}
+
+static void sort_values(float *values, int n)
+{
+    float value;
+    int i, j;
+
+    // Insertion sort, n is at most LOC_MAX_SAMPLES.
+    for (i = 1; i < n; i++)
+    {
+        value = values[i];
+        for (j = i; j > 0 && values[j - 1] > value; j--)
+            values[j] = values[j - 1];
+        values[j] = value;
+    }
+}
+
+static float sorted_median(const float *values, int n)
+{
+    return (n % 2) ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+/*
+Mean and standard deviation of values[first..last).
+*/
+static float mean_spread(const float *values, int first, int last, float *spread)
+{
+    float sum = 0, sum_sq = 0, mean;
+    int n = last - first;
+    int i;
+
+    for (i = first; i < last; i++)
+        sum += values[i];
+    mean = sum / n;
+    for (i = first; i < last; i++)
+        sum_sq += (values[i] - mean) * (values[i] - mean);
+    *spread = (n > 1) ? sqrtf(sum_sq / (n - 1)) : 0;
+    return mean;
+}
+
+/*
+Robust range in centimeters of n sorted valid samples, with its spread.
+*/
+static float estimate_range(float *values, int n, float *spread)
+{
+    float deviation[LOC_MAX_SAMPLES];
+    float median, mad, cutoff;
+    int first, last, i;
+
+    switch (range_estimator)
+    {
+    case RANGE_MEDIAN:
+    case RANGE_MAD:
+        median = sorted_median(values, n);
+        for (i = 0; i < n; i++)
+            deviation[i] = fabsf(values[i] - median);
+        sort_values(deviation, n);
+        mad = RANGE_MAD_SCALE * sorted_median(deviation, n);
+        if (range_estimator == RANGE_MEDIAN)
+        {
+            *spread = mad;
+            return median;
+        }
+        cutoff = RANGE_MAD_CUTOFF * mad;
+        if (cutoff < RANGE_MAD_FLOOR)
+            cutoff = RANGE_MAD_FLOOR;
+        // values is sorted, the kept samples are one contiguous run.
+        for (first = 0; values[first] < median - cutoff; first++)
+            ;
+        for (last = n; values[last - 1] > median + cutoff; last--)
+            ;
+        return mean_spread(values, first, last, spread);
+
+    case RANGE_TRIMMED:
+        first = n * RANGE_TRIM_PERCENT / 100;
+        return mean_spread(values, first, n - first, spread);
+
+    default:
+        return mean_spread(values, 0, n, spread);
+    }
+}
+
+/*
+Slant range r to an anchor dz above the tag, projected onto the tag plane:
+sqrt(r^2 - dz^2). A range shorter than dz (noise) projects to 0. The spread
+grows by dr_h/dr = r / r_h, a range almost straight up says little about the
+floor position.
+*/
+static float project_range(float range, float dz, float *spread)
+{
+    float floor2 = range * range - dz * dz;
+    float projected = (floor2 > 0) ? sqrtf(floor2) : 0;
+
+    *spread = *spread * range / fmaxf(projected, 1.0f);
+    return projected;
+}
+
+/*
+Calibrates the valid samples, reduces them with range_estimator and converts
+centimetres to map pixels via ratio. With HEIGHT_PROJECTED the range is then
+projected onto the tag plane, so every 2D consumer sees floor distances.
+Leaves distance at -1 if no sample was valid. The misses of the anchor are
+counted by plan_record() on the ranging side.
+*/
+void update_anchor_range(struct Anchor *anchor, const struct Range_Sample *samples, int count, float ratio)
+{
+    const struct Range_Calibration *calib = find_calibration(anchor->host_id);
+    float values[LOC_MAX_SAMPLES];
+    float range, spread;
+    int n = 0;
+    int i;
+
+    for (i = 0; i < count && n < LOC_MAX_SAMPLES; i++)
+    {
+        if (samples[i].status != false && samples[i].distance > 0)
+            values[n++] = calibrate_range(calib, samples[i].distance, samples[i].RSSI);
+    }
+
+    anchor->samples = (uint8_t)n;
+    if (n > 0)
+    {
+        sort_values(values, n);
+        range = estimate_range(values, n, &spread);
+        range = range * ratio; // Distance in pixels via ratio multiplication.
+        spread = spread * ratio;
+        if (height_mode == HEIGHT_PROJECTED)
+            range = fmaxf(project_range(range, anchor->z - tag_height, &spread), 1.0f); // Still a valid range
+        anchor->distance = ceilf(range);
+        anchor->spread = spread;
+        anchor->RSSI = samples[count - 1].RSSI;
+    }
+    else
+    {
+        anchor->distance = -1;
+        anchor->spread = 0;
+        anchor->RSSI = 0;
+    }
+}
+
+/*
+Marks every anchor as not ranged, at the start of a ranging cycle.
+*/
+void reset_anchor_ranges(void)
+{
+    struct Anchor *temp_anchor;
+
+    for (temp_anchor = front; temp_anchor != NULL; temp_anchor = temp_anchor->next)
+        temp_anchor->distance = -1;
+}
+
+/*
+Starts the statistics of one anchor, whose calibration applies to the samples.
+*/
+void range_stats_reset(struct Range_Stats *stats, const struct Anchor *anchor)
+{
+    stats->calib = find_calibration(anchor->host_id);
+    stats->valid = 0;
+    stats->failed = 0;
+    stats->mean = 0;
+    stats->m2 = 0;
+}
+
+/*
+Adds one sample and returns true once the anchor needs no more samples: the
+standard error of the mean is within LOC_ADAPTIVE_TOLERANCE centimeters after
+at least LOC_ADAPTIVE_MIN_SAMPLES valid samples, or LOC_ADAPTIVE_MAX_FAILURES
+exchanges have failed.
+*/
+bool range_stats_add(struct Range_Stats *stats, const struct Range_Sample *sample)
+{
+    float delta, distance;
+    float tolerance = LOC_ADAPTIVE_TOLERANCE;
+
+    if (sample->status == false || sample->distance <= 0)
+    {
+        stats->failed++;
+        return stats->failed >= LOC_ADAPTIVE_MAX_FAILURES;
+    }
+
+    distance = calibrate_range(stats->calib, sample->distance, sample->RSSI);
+    stats->valid++;
+    delta = distance - stats->mean;
+    stats->mean += delta / stats->valid;
+    stats->m2 += delta * (distance - stats->mean);
+
+    if (stats->valid < LOC_ADAPTIVE_MIN_SAMPLES)
+        return false;
+    if (stats->valid < 2)
+        return true;
+    // Variance of the mean m2 / (n (n - 1)) against the squared tolerance.
+    return stats->m2 <= tolerance * tolerance * stats->valid * (stats->valid - 1);
+}
@@ -0,0 +1,206 @@
+/*
+ * Indoor Localization solver library
+ *
+ * RANSAC over anchor triples, for fixes that survive ranges in NLOS.
+ */
+
+#include <localization.h>
+
+#include <math.h>
+
+/*
+Each hypothesis is the closed-form fix of three anchors: subtracting the circle
+equation of the first anchor from the other two leaves a 2x2 linear system.
+A hypothesis is scored against every range with the truncated cost
+sum min(res^2, T^2), T = LOC_RANSAC_THRESHOLD, so ranges within T count by
+their residual and the others (NLOS, bad samples) by a constant. The best
+hypothesis is refined by Levenberg-Marquardt on its inliers.
+
+At most LOC_RANSAC_ITERATIONS triples are tried. If the anchors give no more
+triples than that, all of them are tried in order; otherwise the triples are
+drawn from a xorshift32 generator restarted at RANSAC_SEED on every fix, so a
+replay gives the same fixes. The search stops early once every range is an
+inlier.
+*/
+#define RANSAC_THRESHOLD ((float)LOC_RANSAC_THRESHOLD)
+#define RANSAC_SEED 0x9E3779B9u
+#define RANSAC_MIN_DET 1.0f // Triples closer to collinear are skipped
+
+static struct Anchor_Set inlier_set;
+static uint32_t ransac_rng;
+
+static uint32_t ransac_rand(void)
+{
+    ransac_rng ^= ransac_rng << 13;
+    ransac_rng ^= ransac_rng >> 17;
+    ransac_rng ^= ransac_rng << 5;
+    return ransac_rng;
+}
+
+/*
+Intersection of the circles of anchors i, j, k in the least squares sense.
+Returns false if the anchors are (nearly) collinear.
+*/
+static bool solve_triple(const struct Anchor_Set *set, int i, int j, int k, float *x, float *y)
+{
+    float a11 = 2 * (set->x[j] - set->x[i]);
+    float a12 = 2 * (set->y[j] - set->y[i]);
+    float a21 = 2 * (set->x[k] - set->x[i]);
+    float a22 = 2 * (set->y[k] - set->y[i]);
+    float ki = square(set->x[i]) + square(set->y[i]) - square(set->r[i]);
+    float b1 = square(set->x[j]) + square(set->y[j]) - square(set->r[j]) - ki;
+    float b2 = square(set->x[k]) + square(set->y[k]) - square(set->r[k]) - ki;
+    float det = a11 * a22 - a12 * a21;
+
+    if (fabsf(det) < RANSAC_MIN_DET)
+        return false;
+    *x = (b1 * a22 - b2 * a12) / det;
+    *y = (a11 * b2 - a21 * b1) / det;
+    return true;
+}
+
+/*
+Truncated cost of the fix (x, y) and its inlier count.
+*/
+static float ransac_cost(const struct Anchor_Set *set, float x, float y, int *inliers)
+{
+    float limit = RANSAC_THRESHOLD * RANSAC_THRESHOLD;
+    float cost = 0;
+    float res;
+    int i;
+
+    *inliers = 0;
+    for (i = 0; i < set->count; i++)
+    {
+        res = square(hypotf(x - set->x[i], y - set->y[i]) - set->r[i]);
+        if (res < limit)
+        {
+            cost += res;
+            (*inliers)++;
+        }
+        else
+        {
+            cost += limit;
+        }
+    }
+    return cost;
+}
+
+/*
+Picks the next triple, i < j < k. Walks all triples in order when exhaustive,
+otherwise draws three distinct anchors.
+*/
+static bool next_triple(int n, bool exhaustive, int *i, int *j, int *k)
+{
+    int t;
+
+    if (exhaustive)
+    {
+        if (++(*k) < n)
+            return true;
+        if (++(*j) < n - 1)
+        {
+            *k = *j + 1;
+            return true;
+        }
+        if (++(*i) < n - 2)
+        {
+            *j = *i + 1;
+            *k = *j + 1;
+            return true;
+        }
+        return false;
+    }
+
+    *i = (int)(ransac_rand() % (uint32_t)n);
+    *j = (int)(ransac_rand() % (uint32_t)(n - 1));
+    *k = (int)(ransac_rand() % (uint32_t)(n - 2));
+    // Map the draws onto distinct anchors, then sort them.
+    if (*j >= *i)
+        (*j)++;
+    if (*k >= (*i < *j ? *i : *j))
+        (*k)++;
+    if (*k >= (*i > *j ? *i : *j))
+        (*k)++;
+    if (*i > *j)
+    {
+        t = *i;
+        *i = *j;
+        *j = t;
+    }
+    if (*j > *k)
+    {
+        t = *j;
+        *j = *k;
+        *k = t;
+    }
+    if (*i > *j)
+    {
+        t = *i;
+        *i = *j;
+        *j = t;
+    }
+    return true;
+}
+
+struct Coordinates solve_ransac(const struct Anchor_Set *set)
+{
+    struct Coordinates coords = {
+        .flag = false,
+        .x = -1,
+        .y = -1,
+    };
+    struct NLLS_Result refined;
+    float limit = RANSAC_THRESHOLD * RANSAC_THRESHOLD;
+    float x, y, cost, best_cost = INFINITY, best_x = 0, best_y = 0;
+    int n = set->count;
+    int i = 0, j = 1, k = 1, inliers, best_inliers = 0, iter;
+    bool exhaustive;
+
+    if (n < 3)
+        return coords;
+
+    exhaustive = (n * (n - 1) * (n - 2) / 6) <= LOC_RANSAC_ITERATIONS;
+    ransac_rng = RANSAC_SEED;
+    for (iter = 0; iter < LOC_RANSAC_ITERATIONS && best_inliers < n; iter++)
+    {
+        if (!next_triple(n, exhaustive, &i, &j, &k))
+            break;
+        if (!solve_triple(set, i, j, k, &x, &y))
+            continue;
+        cost = ransac_cost(set, x, y, &inliers);
+        if (cost < best_cost)
+        {
+            best_cost = cost;
+            best_inliers = inliers;
+            best_x = x;
+            best_y = y;
+        }
+    }
+    if (best_inliers < 3)
+        return coords;
+
+    coords.x = best_x;
+    coords.y = best_y;
+    coords.flag = true;
+
+    inlier_set.count = 0;
+    for (i = 0; i < n; i++)
+    {
+        if (square(hypotf(best_x - set->x[i], best_y - set->y[i]) - set->r[i]) < limit)
+        {
+            inlier_set.slot[inlier_set.count] = set->slot[i];
+            inlier_set.x[inlier_set.count] = set->x[i];
+            inlier_set.y[inlier_set.count] = set->y[i];
+            inlier_set.r[inlier_set.count] = set->r[i];
+            inlier_set.w[inlier_set.count] = set->w[i];
+            inlier_set.count++;
+        }
+    }
+    if (solve_nlls(&inlier_set, coords, &refined))
+        return refined.coords;
+
+    coords.x = ceilf(best_x);
+    coords.y = ceilf(best_y);
+    return coords;
+}
@@ -0,0 +1,54 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Single-producer/single-consumer ring of ranging rounds (see round_ring.h).
+ */
+
+#include <round_ring.h>
+
+#include <stddef.h>
+
+/*
+head and tail run freely and wrap at 2^32; head - tail is the number of
+published rounds and a slot is the index modulo LOC_ROUND_RING.
+*/
+
+void round_ring_reset(struct Round_Ring *ring)
+{
+    atomic_store_explicit(&ring->head, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->tail, 0, memory_order_relaxed);
+}
+
+struct Ranging_Round *round_ring_claim(struct Round_Ring *ring)
+{
+    unsigned int head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if (head - tail >= LOC_ROUND_RING)
+        return NULL;
+    return &ring->round[head & (LOC_ROUND_RING - 1)];
+}
+
+void round_ring_publish(struct Round_Ring *ring)
+{
+    unsigned int head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+struct Ranging_Round *round_ring_peek(struct Round_Ring *ring)
+{
+    unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    if (head == tail)
+        return NULL;
+    return &ring->round[tail & (LOC_ROUND_RING - 1)];
+}
+
+void round_ring_release(struct Round_Ring *ring)
+{
+    unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+}
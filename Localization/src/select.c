@@ -0,0 +1,184 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Choice of the anchors ranged in a cycle by geometric dilution of precision.
+ */
+
+#include <localization.h>
+
+#include <math.h>
+#include <stddef.h>
+
+/*
+With unit vectors u_i from the anchors to the device, the 2D GDOP of a set of
+ranges is sqrt(trace((H^T H)^-1)) with H^T H = sum u_i u_i^T. Around the last
+fix the plan starts with the nearest anchor (strongest link) and greedily adds
+the anchor that lowers the GDOP most, O(K N). Anchors whose last ranging failed
+are only used when the healthy ones are not enough. Ranging can stop early
+once the valid ranges so far reach LOC_SELECT_GDOP / 100.
+*/
+#define SELECT_REGULARIZATION 1e-3f // Keeps the GDOP of one or two anchors finite
+#define SELECT_MIN_RANGES 3
+
+static float gdop(float sxx, float sxy, float syy)
+{
+    float det = sxx * syy - sxy * sxy;
+
+    if (det <= 0)
+        return INFINITY;
+    return sqrtf((sxx + syy) / det);
+}
+
+static void unit_vector(const struct Anchor *anchor, struct Coordinates fix, float *ux, float *uy)
+{
+    float dx = fix.x - anchor->coords.x;
+    float dy = fix.y - anchor->coords.y;
+    float dist = hypotf(dx, dy);
+
+    if (dist < 1.0f)
+    {
+        *ux = 1.0f;
+        *uy = 0;
+        return;
+    }
+    *ux = dx / dist;
+    *uy = dy / dist;
+}
+
+static void plan_add(struct Ranging_Plan *plan, struct Anchor *anchor, uint16_t index)
+{
+    plan->anchor[plan->count] = anchor;
+    plan->index[plan->count] = index;
+    plan->valid[plan->count] = 0;
+    plan->count++;
+}
+
+/*
+Fills plan with the anchors to range, best first. A full scan, or a cycle
+without a previous fix, ranges the whole queue in queue order. Reads the anchor
+positions and misses, which a solver does not write, so it can run while a
+solver works on the previous round as long as fix is a copy the caller owns.
+*/
+void plan_ranging(struct Ranging_Plan *plan, struct Coordinates fix, int max_anchors, bool full_scan)
+{
+    static struct Anchor *queue[LOC_MAX_ANCHORS];
+    static float ux[LOC_MAX_ANCHORS], uy[LOC_MAX_ANCHORS];
+    static bool taken[LOC_MAX_ANCHORS];
+    struct Anchor *temp_anchor;
+    float sxx = SELECT_REGULARIZATION, sxy = 0, syy = SELECT_REGULARIZATION;
+    float score, best_score, dist, best_dist;
+    int n = 0;
+    int i, best;
+
+    plan->count = 0;
+    plan->full_scan = full_scan || !fix.flag || max_anchors >= anchor_count;
+
+    for (temp_anchor = front; temp_anchor != NULL; temp_anchor = temp_anchor->next)
+    {
+        if (plan->full_scan)
+        {
+            plan_add(plan, temp_anchor, (uint16_t)n);
+        }
+        else
+        {
+            queue[n] = temp_anchor;
+            unit_vector(temp_anchor, fix, &ux[n], &uy[n]);
+            taken[n] = false;
+        }
+        n++;
+    }
+    if (plan->full_scan)
+        return;
+
+    // Nearest healthy anchor first.
+    best = -1;
+    best_dist = INFINITY;
+    for (i = 0; i < n; i++)
+    {
+        dist = hypotf(fix.x - queue[i]->coords.x, fix.y - queue[i]->coords.y);
+        if (queue[i]->misses == 0 && dist < best_dist)
+        {
+            best = i;
+            best_dist = dist;
+        }
+    }
+
+    while (best >= 0)
+    {
+        taken[best] = true;
+        plan_add(plan, queue[best], (uint16_t)best);
+        sxx += ux[best] * ux[best];
+        sxy += ux[best] * uy[best];
+        syy += uy[best] * uy[best];
+        if (plan->count >= max_anchors)
+            break;
+
+        best = -1;
+        best_score = INFINITY;
+        for (i = 0; i < n; i++)
+        {
+            if (taken[i] || queue[i]->misses > 0)
+                continue;
+            score = gdop(sxx + ux[i] * ux[i], sxy + ux[i] * uy[i], syy + uy[i] * uy[i]);
+            if (score < best_score)
+            {
+                best = i;
+                best_score = score;
+            }
+        }
+    }
+
+    // Not enough healthy anchors, retry the failing ones in queue order.
+    for (i = 0; i < n && plan->count < max_anchors; i++)
+    {
+        if (!taken[i])
+            plan_add(plan, queue[i], (uint16_t)i);
+    }
+}
+
+/*
+Updates the misses of the first ranged plan entries from their valid samples.
+Called by the ranging loop once the round is in, so the anchor health is only
+written by the thread that plans with it.
+*/
+void plan_record(const struct Ranging_Plan *plan, int ranged)
+{
+    struct Anchor *anchor;
+    int i;
+
+    for (i = 0; i < ranged && i < plan->count; i++)
+    {
+        anchor = plan->anchor[i];
+        if (plan->valid[i] > 0)
+            anchor->misses = 0;
+        else if (anchor->misses < UINT8_MAX)
+            anchor->misses++;
+    }
+}
+
+/*
+True once the entries with valid samples among the first ranged plan entries
+are well conditioned around fix. Never true for a full scan.
+*/
+bool plan_converged(const struct Ranging_Plan *plan, int ranged, struct Coordinates fix)
+{
+    float sxx = 0, sxy = 0, syy = 0;
+    float ux, uy;
+    int valid = 0;
+    int i;
+
+    if (plan->full_scan)
+        return false;
+
+    for (i = 0; i < ranged && i < plan->count; i++)
+    {
+        if (plan->valid[i] == 0)
+            continue;
+        unit_vector(plan->anchor[i], fix, &ux, &uy);
+        sxx += ux * ux;
+        sxy += ux * uy;
+        syy += uy * uy;
+        valid++;
+    }
+    return valid >= SELECT_MIN_RANGES && gdop(sxx, sxy, syy) * 100 <= LOC_SELECT_GDOP;
+}
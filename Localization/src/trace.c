@@ -0,0 +1,237 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Encoding and decoding of ranging trace records (see trace.h).
+ */
+
+#include <localization.h>
+#include <trace.h>
+#include <wire.h>
+
+#include <stddef.h>
+
+static uint8_t *put_header(uint8_t *p, uint8_t type, int length)
+{
+    p[0] = TRACE_MAGIC;
+    p[1] = type;
+    return wire_put_u16(p + 2, (uint16_t)length);
+}
+
+int trace_encode_map(uint8_t *buf, int size, float ratio)
+{
+    struct Anchor *temp_anchor;
+    int length = TRACE_MAP_SIZE(anchor_count);
+    uint8_t *p;
+
+    if (length > size || length > UINT16_MAX)
+        return -1;
+
+    p = put_header(buf, TRACE_MAP, length);
+    p = wire_put_f32(p, ratio);
+    p = wire_put_f32(p, bottom_left_corner.x);
+    p = wire_put_f32(p, bottom_left_corner.y);
+    p = wire_put_f32(p, top_right_corner.x);
+    p = wire_put_f32(p, top_right_corner.y);
+    p = wire_put_u16(p, (uint16_t)anchor_count);
+    for (temp_anchor = front; temp_anchor != NULL; temp_anchor = temp_anchor->next)
+    {
+        p = wire_put_u32(p, temp_anchor->host_id);
+        p = wire_put_f32(p, temp_anchor->coords.x);
+        p = wire_put_f32(p, temp_anchor->coords.y);
+        p = wire_put_f32(p, temp_anchor->z);
+    }
+    return length;
+}
+
+int trace_encode_round(uint8_t *buf, int size, uint32_t cycle, uint32_t timestamp,
+                       const struct Range_Sample *samples, int count)
+{
+    int length = TRACE_ROUND_SIZE(count);
+    uint8_t *p;
+    int i;
+
+    if (length > size || length > UINT16_MAX)
+        return -1;
+
+    p = put_header(buf, TRACE_ROUND, length);
+    p = wire_put_u32(p, cycle);
+    p = wire_put_u32(p, timestamp);
+    p = wire_put_u16(p, (uint16_t)count);
+    for (i = 0; i < count; i++)
+    {
+        p = wire_put_u16(p, samples[i].anchor);
+        *p++ = samples[i].status ? 1 : 0;
+        p = wire_put_u16(p, (uint16_t)samples[i].RSSI);
+        p = wire_put_f32(p, samples[i].distance);
+        p = wire_put_u16(p, samples[i].dt);
+    }
+    return length;
+}
+
+int trace_encode_calib(uint8_t *buf, int size)
+{
+    const struct Range_Calibration *calib;
+    int length = TRACE_CALIB_SIZE(calibration_count);
+    uint32_t host_id;
+    uint8_t *p;
+    int i;
+
+    if (length > size || length > UINT16_MAX)
+        return -1;
+
+    p = put_header(buf, TRACE_CALIB, length);
+    p = wire_put_u16(p, (uint16_t)calibration_count);
+    for (i = 0; (calib = get_calibration(i, &host_id)) != NULL; i++)
+    {
+        p = wire_put_u32(p, host_id);
+        p = wire_put_f32(p, calib->offset);
+        p = wire_put_f32(p, calib->scale);
+        p = wire_put_f32(p, calib->rssi_slope);
+        p = wire_put_u16(p, (uint16_t)calib->rssi_ref);
+    }
+    return length;
+}
+
+int trace_encode_building(uint8_t *buf, int size)
+{
+    int length = TRACE_BUILDING_SIZE(building.count);
+    uint8_t *p;
+    int i;
+
+    if (length > size || length > UINT16_MAX)
+        return -1;
+
+    p = put_header(buf, TRACE_BUILDING, length);
+    p = wire_put_u16(p, (uint16_t)building.count);
+    for (i = 0; i < building.count; i++)
+    {
+        p = wire_put_f32(p, building.vertex_x[i]);
+        p = wire_put_f32(p, building.vertex_y[i]);
+    }
+    return length;
+}
+
+int trace_record_length(const uint8_t *buf, int len)
+{
+    int length;
+
+    if (len < TRACE_HEADER_SIZE)
+        return 0;
+    if (buf[0] != TRACE_MAGIC || buf[1] < TRACE_MAP || buf[1] > TRACE_BUILDING)
+        return -1;
+    length = wire_get_u16(buf + 2);
+    if (length < TRACE_HEADER_SIZE)
+        return -1;
+    return (len < length) ? 0 : length;
+}
+
+int trace_load_map(const uint8_t *buf, int len, float *ratio)
+{
+    struct Coordinates coords = {.flag = true};
+    const uint8_t *p = buf + TRACE_HEADER_SIZE;
+    int count, i;
+
+    if (trace_record_length(buf, len) <= 0 || buf[1] != TRACE_MAP || len < TRACE_MAP_SIZE(0))
+        return -1;
+
+    count = wire_get_u16(buf + TRACE_MAP_SIZE(0) - 2);
+    if (wire_get_u16(buf + 2) != TRACE_MAP_SIZE(count) || len < TRACE_MAP_SIZE(count))
+        return -1;
+
+    *ratio = wire_get_f32(p);
+    bottom_left_corner.flag = true;
+    bottom_left_corner.x = wire_get_f32(p + 4);
+    bottom_left_corner.y = wire_get_f32(p + 8);
+    top_right_corner.flag = true;
+    top_right_corner.x = wire_get_f32(p + 12);
+    top_right_corner.y = wire_get_f32(p + 16);
+
+    remove_all_anchors();
+    p = buf + TRACE_MAP_SIZE(0);
+    for (i = 0; i < count; i++, p += TRACE_MAP_ANCHOR_SIZE)
+    {
+        coords.x = wire_get_f32(p + 4);
+        coords.y = wire_get_f32(p + 8);
+        if (!add_anchor(wire_get_u32(p), coords, wire_get_f32(p + 12)))
+            return -1;
+    }
+    return count;
+}
+
+int trace_load_calib(const uint8_t *buf, int len)
+{
+    struct Range_Calibration calib;
+    const uint8_t *p;
+    int count, i;
+
+    if (trace_record_length(buf, len) <= 0 || buf[1] != TRACE_CALIB || len < TRACE_CALIB_SIZE(0))
+        return -1;
+
+    count = wire_get_u16(buf + TRACE_HEADER_SIZE);
+    if (len < TRACE_CALIB_SIZE(count))
+        return -1;
+
+    remove_all_calibrations();
+    p = buf + TRACE_CALIB_SIZE(0);
+    for (i = 0; i < count; i++, p += TRACE_CALIB_ENTRY_SIZE)
+    {
+        calib.offset = wire_get_f32(p + 4);
+        calib.scale = wire_get_f32(p + 8);
+        calib.rssi_slope = wire_get_f32(p + 12);
+        calib.rssi_ref = (int16_t)wire_get_u16(p + 16);
+        if (!set_calibration(wire_get_u32(p), &calib))
+            return -1;
+    }
+    return count;
+}
+
+int trace_load_building(const uint8_t *buf, int len)
+{
+    float x[LOC_MAX_VERTICES], y[LOC_MAX_VERTICES];
+    const uint8_t *p;
+    int count, i;
+
+    if (trace_record_length(buf, len) <= 0 || buf[1] != TRACE_BUILDING || len < TRACE_BUILDING_SIZE(0))
+        return -1;
+
+    count = wire_get_u16(buf + TRACE_HEADER_SIZE);
+    if (count > LOC_MAX_VERTICES || len < TRACE_BUILDING_SIZE(count))
+        return -1;
+
+    p = buf + TRACE_BUILDING_SIZE(0);
+    for (i = 0; i < count; i++, p += TRACE_VERTEX_SIZE)
+    {
+        x[i] = wire_get_f32(p);
+        y[i] = wire_get_f32(p + 4);
+    }
+    if (!set_building(x, y, count))
+        return -1;
+    return count;
+}
+
+int trace_decode_round(const uint8_t *buf, int len, uint32_t *cycle, uint32_t *timestamp,
+                       struct Range_Sample *samples, int max_samples)
+{
+    const uint8_t *p = buf + TRACE_HEADER_SIZE;
+    int count, i;
+
+    if (trace_record_length(buf, len) <= 0 || buf[1] != TRACE_ROUND || len < TRACE_ROUND_SIZE(0))
+        return -1;
+
+    *cycle = wire_get_u32(p);
+    *timestamp = wire_get_u32(p + 4);
+    count = wire_get_u16(p + 8);
+    if (count > max_samples || len < TRACE_ROUND_SIZE(count))
+        return -1;
+
+    p = buf + TRACE_ROUND_SIZE(0);
+    for (i = 0; i < count; i++, p += TRACE_SAMPLE_SIZE)
+    {
+        samples[i].anchor = wire_get_u16(p);
+        samples[i].status = p[2] != 0;
+        samples[i].RSSI = (int16_t)wire_get_u16(p + 3);
+        samples[i].distance = wire_get_f32(p + 5);
+        samples[i].dt = wire_get_u16(p + 9);
+    }
+    return count;
+}
@@ -0,0 +1,198 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Constant-velocity extended Kalman filter on top of the per-cycle fixes.
+ */
+
+#include <localization.h>
+
+#include <math.h>
+
+/*
+The state is position and velocity in map pixels. Every anchor range is fused
+as soon as it is measured with a scalar EKF update, so the track moves with
+each ranging exchange instead of once per cycle. The range noise grows as the
+RSSI drops below TRACKER_RSSI_REF, TRACKER_RSSI_SCALE dB below it doubles the
+standard deviation, and a range whose samples spread wider than that uses
+their spread instead. Ranges further than TRACKER_GATE standard deviations from
+the prediction are rejected. The raw solver fixes only start the track, and
+restart it after TRACKER_MAX_MISSED cycles in which every range was rejected.
+*/
+#define TRACKER_RSSI_REF -80
+#define TRACKER_RSSI_SCALE 10.0f
+#define TRACKER_GATE 16.0f // Squared innovation over its variance (4 sigma)
+#define TRACKER_MAX_MISSED 3
+#define TRACKER_VELOCITY_SIGMA 200.0f // Initial velocity uncertainty in pixels/s
+#define TRACKER_MIN_DIST 1.0f
+
+struct Tracker tracker;
+
+static float range_variance(const struct Anchor *anchor)
+{
+    float sigma = LOC_TRACKER_RANGE_SIGMA;
+
+    if (anchor->RSSI < TRACKER_RSSI_REF)
+        sigma = sigma * (1.0f + (TRACKER_RSSI_REF - anchor->RSSI) / TRACKER_RSSI_SCALE);
+    if (anchor->spread > sigma)
+        sigma = anchor->spread;
+    return sigma * sigma;
+}
+
+void tracker_reset(struct Tracker *t)
+{
+    int i, j;
+
+    t->started = false;
+    t->missed = 0;
+    t->accepted = 0;
+    t->timestamp = 0;
+    for (i = 0; i < 4; i++)
+    {
+        t->state[i] = 0;
+        for (j = 0; j < 4; j++)
+            t->cov[i][j] = 0;
+    }
+}
+
+static void tracker_start(struct Tracker *t, struct Coordinates fix, uint32_t timestamp)
+{
+    float pos_var = (float)LOC_TRACKER_RANGE_SIGMA * LOC_TRACKER_RANGE_SIGMA;
+
+    tracker_reset(t);
+    t->started = true;
+    t->timestamp = timestamp;
+    t->state[0] = fix.x;
+    t->state[1] = fix.y;
+    t->cov[0][0] = pos_var;
+    t->cov[1][1] = pos_var;
+    t->cov[2][2] = TRACKER_VELOCITY_SIGMA * TRACKER_VELOCITY_SIGMA;
+    t->cov[3][3] = TRACKER_VELOCITY_SIGMA * TRACKER_VELOCITY_SIGMA;
+}
+
+/*
+Advances the state to timestamp (ms). P = F P F^T + Q with the white
+acceleration model, F couples each position to its velocity by dt.
+*/
+void tracker_predict(struct Tracker *t, uint32_t timestamp)
+{
+    float dt = (uint32_t)(timestamp - t->timestamp) * 0.001f;
+    float q = (float)LOC_TRACKER_ACCEL_NOISE * LOC_TRACKER_ACCEL_NOISE;
+    float dt2, dt3;
+    int i;
+
+    if (!t->started || dt <= 0)
+        return;
+
+    t->state[0] += t->state[2] * dt;
+    t->state[1] += t->state[3] * dt;
+
+    // P F^T, then F (P F^T). Columns/rows 0, 1 pick up dt times columns/rows 2, 3.
+    for (i = 0; i < 4; i++)
+    {
+        t->cov[i][0] += t->cov[i][2] * dt;
+        t->cov[i][1] += t->cov[i][3] * dt;
+    }
+    for (i = 0; i < 4; i++)
+    {
+        t->cov[0][i] += t->cov[2][i] * dt;
+        t->cov[1][i] += t->cov[3][i] * dt;
+    }
+
+    dt2 = dt * dt;
+    dt3 = dt2 * dt;
+    for (i = 0; i < 2; i++)
+    {
+        t->cov[i][i] += q * dt3 / 3;
+        t->cov[i][i + 2] += q * dt2 / 2;
+        t->cov[i + 2][i] += q * dt2 / 2;
+        t->cov[i + 2][i + 2] += q * dt;
+    }
+    t->timestamp = timestamp;
+}
+
+/*
+Predicts to timestamp and fuses the range of one anchor. Returns false if the
+track has not started, the anchor has no range or the range was gated out.
+*/
+bool tracker_range(struct Tracker *t, const struct Anchor *anchor, uint32_t timestamp)
+{
+    float ph[4], gain[4];
+    float dx, dy, dist, ux, uy, innovation, s;
+    int i, j;
+
+    if (!t->started || anchor->distance <= 0)
+        return false;
+
+    tracker_predict(t, timestamp);
+
+    dx = t->state[0] - anchor->coords.x;
+    dy = t->state[1] - anchor->coords.y;
+    dist = hypotf(dx, dy);
+    if (dist < TRACKER_MIN_DIST)
+        return false;
+    ux = dx / dist;
+    uy = dy / dist;
+
+    // H = [ux uy 0 0], ph = P H^T, s = H P H^T + R
+    for (i = 0; i < 4; i++)
+        ph[i] = t->cov[i][0] * ux + t->cov[i][1] * uy;
+    s = ux * ph[0] + uy * ph[1] + range_variance(anchor);
+    innovation = anchor->distance - dist;
+    if (innovation * innovation > TRACKER_GATE * s)
+        return false;
+
+    for (i = 0; i < 4; i++)
+    {
+        gain[i] = ph[i] / s;
+        t->state[i] += gain[i] * innovation;
+    }
+    for (i = 0; i < 4; i++)
+    {
+        for (j = i; j < 4; j++)
+        {
+            t->cov[i][j] -= gain[i] * ph[j];
+            t->cov[j][i] = t->cov[i][j];
+        }
+    }
+    t->accepted++;
+    return true;
+}
+
+/*
+Closes a ranging cycle. Starts the track from the first valid fix and
+restarts it from the fix once TRACKER_MAX_MISSED cycles in a row had every
+range rejected.
+*/
+void tracker_round(struct Tracker *t, struct Coordinates fix, uint32_t timestamp)
+{
+    if (t->started && t->accepted == 0)
+        t->missed++;
+    else if (t->started)
+        t->missed = 0;
+    t->accepted = 0;
+
+    if (fix.flag && (!t->started || t->missed >= TRACKER_MAX_MISSED))
+        tracker_start(t, fix, timestamp);
+}
+
+/*
+Position extrapolated to timestamp without changing the state.
+*/
+struct Coordinates tracker_position(const struct Tracker *t, uint32_t timestamp)
+{
+    struct Coordinates coords = {
+        .flag = false,
+        .x = -1,
+        .y = -1,
+    };
+    float dt;
+
+    if (!t->started)
+        return coords;
+
+    dt = (uint32_t)(timestamp - t->timestamp) * 0.001f;
+    coords.x = ceilf(t->state[0] + t->state[2] * dt);
+    coords.y = ceilf(t->state[1] + t->state[3] * dt);
+    coords.flag = true;
+    return coords;
+}
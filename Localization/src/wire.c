@@ -0,0 +1,387 @@
+/*
+ * Indoor Localization solver library
+ *
+ * Encoding and decoding of anchor table frames (see wire.h).
+ */
+
+#include <localization.h>
+#include <wire.h>
+
+#include <stddef.h>
+
+/*
+FNV-1a, 32 bit.
+*/
+uint32_t wire_hash(uint32_t hash, const uint8_t *p, int len)
+{
+    int i;
+
+    for (i = 0; i < len; i++)
+    {
+        hash ^= p[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void wire_frame_begin(struct Wire_Frame *frame, uint32_t host_id, uint8_t version)
+{
+    uint8_t *p = wire_put_u32(frame->buf, host_id);
+
+    *p++ = ANCHOR_TABLE_PKT;
+    *p = version;
+    frame->version = version;
+    frame->hash = WIRE_HASH_INIT;
+    frame->run = 0;
+    frame->len = WIRE_HEADER_SIZE;
+}
+
+/*
+The records are hashed once the frame is complete, a compact anchor record
+still grows its count until then.
+*/
+void wire_frame_next(struct Wire_Frame *frame)
+{
+    frame->hash = wire_table_hash(frame);
+    frame->run = 0;
+    frame->len = WIRE_HEADER_SIZE;
+}
+
+uint32_t wire_table_hash(const struct Wire_Frame *frame)
+{
+    return wire_hash(frame->hash, frame->buf + WIRE_HEADER_SIZE, frame->len - WIRE_HEADER_SIZE);
+}
+
+static uint8_t *put_i16(uint8_t *p, float value, float unit)
+{
+    return wire_put_u16(p, (uint16_t)wire_quantize(value, unit));
+}
+
+static float get_i16(const uint8_t *p, float unit)
+{
+    return wire_dequantize((int16_t)wire_get_u16(p), unit);
+}
+
+/*
+Compact anchors extend the record of the anchor just before them while it has
+the same flags, so a map of flat anchors costs one 3 byte header in total.
+*/
+static bool put_compact_anchor(struct Wire_Frame *frame, uint32_t host_id, struct Coordinates coords, float z)
+{
+    uint8_t flags = wire_quantize(z, WIRE_PIXEL_UNIT) != 0 ? WIRE_ANCHOR_Z : 0;
+    bool extend = frame->run > 0 && frame->buf[frame->run + 1] < UINT8_MAX && frame->buf[frame->run + 2] == flags;
+    int size = WIRE_COMPACT_ANCHOR_SIZE(flags) + (extend ? 0 : WIRE_RUN_SIZE);
+    uint8_t *p = frame->buf + frame->len;
+
+    if (frame->len + size > WIRE_FRAME_SIZE)
+        return false;
+
+    if (!extend)
+    {
+        frame->run = frame->len;
+        *p++ = WIRE_ANCHOR;
+        *p++ = 0;
+        *p++ = flags;
+    }
+    frame->buf[frame->run + 1]++;
+    p = wire_put_u32(p, host_id);
+    p = put_i16(p, coords.x, WIRE_PIXEL_UNIT);
+    p = put_i16(p, coords.y, WIRE_PIXEL_UNIT);
+    if (flags & WIRE_ANCHOR_Z)
+        put_i16(p, z, WIRE_PIXEL_UNIT);
+    frame->len += size;
+    return true;
+}
+
+bool wire_put_anchor(struct Wire_Frame *frame, uint32_t host_id, struct Coordinates coords, float z)
+{
+    uint8_t *p = frame->buf + frame->len;
+
+    if (frame->version == WIRE_VERSION_COMPACT)
+        return put_compact_anchor(frame, host_id, coords, z);
+
+    if (frame->len + WIRE_ANCHOR_SIZE > WIRE_FRAME_SIZE)
+        return false;
+
+    *p++ = WIRE_ANCHOR;
+    p = wire_put_u32(p, host_id);
+    p = wire_put_f32(p, coords.x);
+    p = wire_put_f32(p, coords.y);
+    wire_put_f32(p, z);
+    frame->len += WIRE_ANCHOR_SIZE;
+    return true;
+}
+
+bool wire_put_calib(struct Wire_Frame *frame, uint32_t host_id, const struct Range_Calibration *calib)
+{
+    bool compact = frame->version == WIRE_VERSION_COMPACT;
+    int size = compact ? WIRE_COMPACT_CALIB_SIZE : WIRE_CALIB_SIZE;
+    uint8_t *p = frame->buf + frame->len;
+
+    if (frame->len + size > WIRE_FRAME_SIZE)
+        return false;
+
+    *p++ = WIRE_CALIB;
+    p = wire_put_u32(p, host_id);
+    if (compact)
+    {
+        p = put_i16(p, calib->offset, WIRE_OFFSET_UNIT);
+        p = put_i16(p, calib->scale - 1, WIRE_SCALE_UNIT);
+        p = put_i16(p, calib->rssi_slope, WIRE_SLOPE_UNIT);
+        *p = (uint8_t)(int8_t)(calib->rssi_ref < INT8_MIN ? INT8_MIN : calib->rssi_ref > INT8_MAX ? INT8_MAX : calib->rssi_ref);
+    }
+    else
+    {
+        p = wire_put_f32(p, calib->offset);
+        p = wire_put_f32(p, calib->scale);
+        p = wire_put_f32(p, calib->rssi_slope);
+        wire_put_u16(p, (uint16_t)calib->rssi_ref);
+    }
+    frame->run = 0;
+    frame->len += size;
+    return true;
+}
+
+bool wire_put_outline(struct Wire_Frame *frame, const float *x, const float *y, int count)
+{
+    bool compact = frame->version == WIRE_VERSION_COMPACT;
+    int size = compact ? WIRE_COMPACT_OUTLINE_SIZE(count) : WIRE_OUTLINE_SIZE(count);
+    uint8_t *p = frame->buf + frame->len;
+    int i;
+
+    if (count < 0 || count > UINT8_MAX || frame->len + size > WIRE_FRAME_SIZE)
+        return false;
+
+    *p++ = WIRE_OUTLINE;
+    *p++ = (uint8_t)count;
+    for (i = 0; i < count; i++)
+    {
+        if (compact)
+        {
+            p = put_i16(p, x[i], WIRE_PIXEL_UNIT);
+            p = put_i16(p, y[i], WIRE_PIXEL_UNIT);
+        }
+        else
+        {
+            p = wire_put_f32(p, x[i]);
+            p = wire_put_f32(p, y[i]);
+        }
+    }
+    frame->run = 0;
+    frame->len += size;
+    return true;
+}
+
+bool wire_put_done(struct Wire_Frame *frame)
+{
+    if (frame->len + WIRE_DONE_SIZE > WIRE_FRAME_SIZE)
+        return false;
+
+    frame->buf[frame->len++] = WIRE_DONE;
+    frame->run = 0;
+    return true;
+}
+
+bool wire_put_map_id(struct Wire_Frame *frame, uint32_t map_id)
+{
+    if (frame->len + WIRE_MAP_ID_SIZE > WIRE_FRAME_SIZE)
+        return false;
+
+    frame->buf[frame->len] = WIRE_MAP_ID;
+    wire_put_u32(frame->buf + frame->len + 1, map_id);
+    frame->run = 0;
+    frame->len += WIRE_MAP_ID_SIZE;
+    return true;
+}
+
+/*
+Each loader applies the record at p and returns its length, or -1 if it is
+truncated or invalid.
+*/
+static int load_float_record(const uint8_t *p, int avail)
+{
+    float x[LOC_MAX_VERTICES], y[LOC_MAX_VERTICES];
+    struct Coordinates coords = {.flag = true};
+    struct Range_Calibration calib;
+    int count, i;
+
+    switch (*p)
+    {
+    case WIRE_ANCHOR:
+        if (avail < WIRE_ANCHOR_SIZE)
+            return -1;
+        coords.x = wire_get_f32(p + 5);
+        coords.y = wire_get_f32(p + 9);
+        add_anchor(wire_get_u32(p + 1), coords, wire_get_f32(p + 13));
+        return WIRE_ANCHOR_SIZE;
+    case WIRE_CALIB:
+        if (avail < WIRE_CALIB_SIZE)
+            return -1;
+        calib.offset = wire_get_f32(p + 5);
+        calib.scale = wire_get_f32(p + 9);
+        calib.rssi_slope = wire_get_f32(p + 13);
+        calib.rssi_ref = (int16_t)wire_get_u16(p + 17);
+        set_calibration(wire_get_u32(p + 1), &calib);
+        return WIRE_CALIB_SIZE;
+    case WIRE_OUTLINE:
+        if (avail < 2)
+            return -1;
+        count = p[1];
+        if (count > LOC_MAX_VERTICES || avail < WIRE_OUTLINE_SIZE(count))
+            return -1;
+        for (i = 0; i < count; i++)
+        {
+            x[i] = wire_get_f32(p + 2 + 8 * i);
+            y[i] = wire_get_f32(p + 6 + 8 * i);
+        }
+        if (!set_building(x, y, count))
+            return -1;
+        return WIRE_OUTLINE_SIZE(count);
+    }
+    return -1;
+}
+
+static int load_compact_record(const uint8_t *p, int avail)
+{
+    float x[LOC_MAX_VERTICES], y[LOC_MAX_VERTICES];
+    struct Coordinates coords = {.flag = true};
+    struct Range_Calibration calib;
+    const uint8_t *q;
+    int count, size, i;
+    float z;
+
+    switch (*p)
+    {
+    case WIRE_ANCHOR:
+        if (avail < WIRE_RUN_SIZE)
+            return -1;
+        count = p[1];
+        size = WIRE_COMPACT_ANCHOR_SIZE(p[2]);
+        if (avail < WIRE_RUN_SIZE + count * size)
+            return -1;
+        for (i = 0, q = p + WIRE_RUN_SIZE; i < count; i++, q += size)
+        {
+            coords.x = get_i16(q + 4, WIRE_PIXEL_UNIT);
+            coords.y = get_i16(q + 6, WIRE_PIXEL_UNIT);
+            z = (p[2] & WIRE_ANCHOR_Z) ? get_i16(q + 8, WIRE_PIXEL_UNIT) : 0.0f;
+            add_anchor(wire_get_u32(q), coords, z);
+        }
+        return WIRE_RUN_SIZE + count * size;
+    case WIRE_CALIB:
+        if (avail < WIRE_COMPACT_CALIB_SIZE)
+            return -1;
+        calib.offset = get_i16(p + 5, WIRE_OFFSET_UNIT);
+        calib.scale = 1 + get_i16(p + 7, WIRE_SCALE_UNIT);
+        calib.rssi_slope = get_i16(p + 9, WIRE_SLOPE_UNIT);
+        calib.rssi_ref = (int8_t)p[11];
+        set_calibration(wire_get_u32(p + 1), &calib);
+        return WIRE_COMPACT_CALIB_SIZE;
+    case WIRE_OUTLINE:
+        if (avail < 2)
+            return -1;
+        count = p[1];
+        if (count > LOC_MAX_VERTICES || avail < WIRE_COMPACT_OUTLINE_SIZE(count))
+            return -1;
+        for (i = 0; i < count; i++)
+        {
+            x[i] = get_i16(p + 2 + 4 * i, WIRE_PIXEL_UNIT);
+            y[i] = get_i16(p + 4 + 4 * i, WIRE_PIXEL_UNIT);
+        }
+        if (!set_building(x, y, count))
+            return -1;
+        return WIRE_COMPACT_OUTLINE_SIZE(count);
+    }
+    return -1;
+}
+
+int wire_load_records(uint8_t version, const uint8_t *p, int len)
+{
+    const uint8_t *end = p + len;
+    int records = 0;
+    int size;
+
+    while (p < end)
+    {
+        if (version == WIRE_VERSION_COMPACT)
+            size = load_compact_record(p, (int)(end - p));
+        else if (version == WIRE_VERSION_FLOAT)
+            size = load_float_record(p, (int)(end - p));
+        else
+            return -1;
+        if (size < 0)
+            return -1;
+        p += size;
+        records++;
+    }
+    return records;
+}
+
+void wire_table_begin(struct Wire_Table *table)
+{
+    table->version = 0;
+    table->done = false;
+    table->has_map_id = false;
+    table->hash = WIRE_HASH_INIT;
+    table->len = 0;
+}
+
+/*
+An anchor the pool has no room for, or a duplicate, is skipped like a
+duplicate ANCHOR_PKT; only a truncated or unknown record, or a version other
+than the one the table started with, stops the frame. The map id and done
+records are the same in every version and end the table.
+*/
+int wire_load_frame(const uint8_t *buf, int len, struct Wire_Table *table)
+{
+    const uint8_t *p = buf + WIRE_HEADER_SIZE;
+    const uint8_t *end = buf + len;
+    int records = 0;
+    int size;
+
+    if (len < WIRE_HEADER_SIZE || buf[4] != ANCHOR_TABLE_PKT || table->done)
+        return -1;
+    if (buf[5] != WIRE_VERSION_FLOAT && buf[5] != WIRE_VERSION_COMPACT)
+        return -1;
+    if (table->version == 0)
+        table->version = buf[5];
+    if (buf[5] != table->version)
+        return -1;
+
+    while (p < end)
+    {
+        switch (*p)
+        {
+        case WIRE_MAP_ID:
+            if (end - p < WIRE_MAP_ID_SIZE)
+                return -1;
+            table->map_id = wire_get_u32(p + 1);
+            table->has_map_id = true;
+            size = WIRE_MAP_ID_SIZE;
+            break;
+        case WIRE_DONE:
+            table->done = true;
+            size = WIRE_DONE_SIZE;
+            break;
+        default:
+            if (table->has_map_id)
+                return -1;
+            if (table->version == WIRE_VERSION_COMPACT)
+                size = load_compact_record(p, (int)(end - p));
+            else
+                size = load_float_record(p, (int)(end - p));
+            if (size < 0)
+                return -1;
+            table->hash = wire_hash(table->hash, p, size);
+            if (table->len >= 0 && table->len + size <= LOC_MAP_CACHE_SIZE)
+            {
+                memcpy(table->records + table->len, p, size);
+                table->len += size;
+            }
+            else
+                table->len = -1;
+        }
+        p += size;
+        records++;
+    }
+    return records;
+}
@@ -0,0 +1,37 @@
+/*
+ * Indoor Localization host tests
+ *
+ * Minimal check macros shared by the test programs: a failed check prints
+ * its location and the test keeps going, main() returns test_result().
+ */
+
+#ifndef LOCALIZATION_TEST_H_
+#define LOCALIZATION_TEST_H_
+
+#include <math.h>
+#include <stdio.h>
+
+static int test_failures;
+
+#define CHECK(cond)                                                             \
+    do                                                                          \
+    {                                                                           \
+        if (!(cond))                                                            \
+        {                                                                       \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            test_failures++;                                                    \
+        }                                                                       \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tolerance) CHECK(fabsf((float)(a) - (float)(b)) <= (tolerance))
+
+static inline int test_result(const char *name)
+{
+    if (test_failures > 0)
+        fprintf(stderr, "%s: %d check(s) failed\n", name, test_failures);
+    else
+        printf("%s: ok\n", name);
+    return test_failures > 0;
+}
+
+#endif /* LOCALIZATION_TEST_H_ */
@@ -0,0 +1,211 @@
+/*
+ * Indoor Localization building outline tests
+ *
+ * Compares is_inside_building() with a reference even-odd test on concave
+ * outlines with horizontal edges, checks points level with vertices, and
+ * checks that points on a shared edge or vertex belong to exactly one of the
+ * outlines that share it.
+ */
+
+#include <localization.h>
+
+#include "test.h"
+
+#include <stdlib.h>
+
+#define RANDOM_POINTS 200000
+
+struct Outline
+{
+    int count;
+    float x[LOC_MAX_VERTICES];
+    float y[LOC_MAX_VERTICES];
+};
+
+// L shape: horizontal edges at y = 0, 800 and 2000, a reflex vertex at (1000, 800).
+static const struct Outline l_shape = {
+    .count = 6,
+    .x = {0, 2000, 2000, 1000, 1000, 0},
+    .y = {0, 0, 800, 800, 2000, 2000},
+};
+
+// Comb: three teeth pointing up, several vertices on the same rows.
+static const struct Outline comb = {
+    .count = 12,
+    .x = {0, 1500, 1500, 1300, 1300, 1000, 1000, 700, 700, 400, 400, 0},
+    .y = {0, 0, 1500, 1500, 500, 500, 1500, 1500, 500, 500, 1500, 1500},
+};
+
+// Concave arrow with a slanted reflex vertex, listed clockwise.
+static const struct Outline arrow = {
+    .count = 7,
+    .x = {300, 0, 0, 1000, 1000, 2000, 2000},
+    .y = {1000, 2000, 0, 0, 800, 800, 2000},
+};
+
+/*
+Reference even-odd crossing test, ray towards +x.
+*/
+static bool reference_inside(const struct Outline *o, float px, float py)
+{
+    bool inside = false;
+    int i, j;
+
+    for (i = 0, j = o->count - 1; i < o->count; j = i++)
+    {
+        if ((o->y[i] > py) != (o->y[j] > py) &&
+            px < (o->x[j] - o->x[i]) * (py - o->y[i]) / (o->y[j] - o->y[i]) + o->x[i])
+            inside = !inside;
+    }
+    return inside;
+}
+
+static bool inside(float x, float y)
+{
+    struct Coordinates coords = {.flag = true, .x = x, .y = y};
+    return is_inside_building(coords);
+}
+
+static bool set_outline(const struct Outline *o)
+{
+    return set_building(o->x, o->y, o->count);
+}
+
+/*
+Random points off the grid of vertex coordinates, so none lies on an edge.
+*/
+static void test_reference(const struct Outline *o)
+{
+    int mismatches = 0;
+    float x, y;
+    int k;
+
+    CHECK(set_outline(o));
+    srand(1);
+    for (k = 0; k < RANDOM_POINTS; k++)
+    {
+        x = (float)(rand() % 2400 - 200) + 0.37f;
+        y = (float)(rand() % 2400 - 200) + 0.61f;
+        if (inside(x, y) != reference_inside(o, x, y))
+            mismatches++;
+    }
+    CHECK(mismatches == 0);
+}
+
+/*
+A ray through a vertex or along a horizontal edge crosses the outline once
+per real crossing: points level with vertices are classified like their
+neighbours just above and below.
+*/
+static void test_vertex_rows(const struct Outline *o)
+{
+    int mismatches = 0;
+    float x;
+    int i;
+
+    CHECK(set_outline(o));
+    for (i = 0; i < o->count; i++)
+    {
+        for (x = -150.5f; x < 2200; x += 25)
+        {
+            // x is never a vertex abscissa, and both tests take edge spans half-open in y.
+            if (inside(x, o->y[i]) != reference_inside(o, x, o->y[i]))
+                mismatches++;
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+static void test_l_shape(void)
+{
+    CHECK(set_outline(&l_shape));
+
+    // Bounding box becomes the building corners.
+    CHECK(bottom_left_corner.flag && top_right_corner.flag);
+    CHECK(bottom_left_corner.x == 0 && bottom_left_corner.y == 0);
+    CHECK(top_right_corner.x == 2000 && top_right_corner.y == 2000);
+
+    CHECK(inside(500, 500));
+    CHECK(inside(1500, 500));
+    CHECK(inside(500, 1500));
+    CHECK(!inside(1500, 1500)); // The notch, inside the bounding box
+    CHECK(!inside(2500, 500));
+    CHECK(!inside(-1, 500));
+
+    // Level with the horizontal edge and the reflex vertex.
+    CHECK(inside(500, 800));
+    CHECK(inside(999, 800));
+    CHECK(inside(1500, 799.5f));
+    CHECK(!inside(1500, 800.5f));
+    CHECK(!inside(2100, 800));
+
+    // Level with the top and bottom edges, away from them.
+    CHECK(!inside(1500, 2000));
+    CHECK(!inside(2100, 0));
+}
+
+/*
+Four squares around a common vertex tile their bounding square: every point
+of an inner edge, the common vertex included, is in exactly one of them.
+*/
+static void test_shared_boundary(void)
+{
+    static const struct Outline quadrant[4] = {
+        {.count = 4, .x = {0, 1000, 1000, 0}, .y = {0, 0, 1000, 1000}},
+        {.count = 4, .x = {1000, 2000, 2000, 1000}, .y = {0, 0, 1000, 1000}},
+        {.count = 4, .x = {1000, 2000, 2000, 1000}, .y = {1000, 1000, 2000, 2000}},
+        {.count = 4, .x = {0, 1000, 1000, 0}, .y = {1000, 1000, 2000, 2000}},
+    };
+    static uint8_t hits[2][39];
+    float t;
+    int q, k;
+
+    for (q = 0; q < 4; q++)
+    {
+        CHECK(set_outline(&quadrant[q]));
+        for (k = 0; k < 39; k++)
+        {
+            t = 50.0f * (k + 1);
+            hits[0][k] += inside(1000, t); // Vertical inner edge, (1000, 1000) included
+            hits[1][k] += inside(t, 1000); // Horizontal inner edge
+        }
+    }
+    for (k = 0; k < 39; k++)
+    {
+        CHECK(hits[0][k] == 1);
+        CHECK(hits[1][k] == 1);
+    }
+}
+
+static void test_corner_fallback(void)
+{
+    remove_building();
+    bottom_left_corner = (struct Coordinates){.flag = true, .x = 100, .y = 100};
+    top_right_corner = (struct Coordinates){.flag = true, .x = 900, .y = 900};
+    CHECK(inside(500, 500));
+    CHECK(!inside(100, 500)); // On the rectangle: outside, as before outlines
+    CHECK(!inside(950, 500));
+}
+
+static void test_invalid_outline(void)
+{
+    CHECK(set_outline(&l_shape));
+    CHECK(!set_building(l_shape.x, l_shape.y, 2));
+    CHECK(!set_building(l_shape.x, l_shape.y, LOC_MAX_VERTICES + 1));
+    CHECK(building.count == l_shape.count); // Unchanged on failure
+}
+
+int main(void)
+{
+    test_reference(&l_shape);
+    test_reference(&comb);
+    test_reference(&arrow);
+    test_vertex_rows(&l_shape);
+    test_vertex_rows(&comb);
+    test_vertex_rows(&arrow);
+    test_l_shape();
+    test_shared_boundary();
+    test_corner_fallback();
+    test_invalid_outline();
+    return test_result("test_building");
+}
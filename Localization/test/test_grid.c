@@ -0,0 +1,63 @@
+/*
+ * Indoor Localization grid solver tests
+ *
+ * Without building corners the grid covers the padded anchor bounding box:
+ * a tag outside the anchors' hull is still found, and a tag beyond the
+ * padding gives no fix instead of one clamped to the border.
+ */
+
+#include <localization.h>
+
+#include "test.h"
+
+#include <math.h>
+
+static const float ax[3] = {1000, 2000, 2000};
+static const float ay[3] = {1000, 1000, 2000};
+
+static struct Coordinates locate_tag(float tx, float ty)
+{
+    struct Anchor *anchor_ptr;
+
+    for (anchor_ptr = front; anchor_ptr != NULL; anchor_ptr = anchor_ptr->next)
+        anchor_ptr->distance = hypotf(anchor_ptr->coords.x - tx, anchor_ptr->coords.y - ty);
+    load_anchor_set(&anchor_set);
+    return solve_grid(&anchor_set);
+}
+
+int main(void)
+{
+    struct Coordinates coords = {.flag = true};
+    struct Coordinates fix;
+    int k;
+
+    remove_building();
+    bottom_left_corner.flag = false;
+    top_right_corner.flag = false;
+    remove_all_anchors();
+    for (k = 0; k < 3; k++)
+    {
+        coords.x = ax[k];
+        coords.y = ay[k];
+        add_anchor(0x1000 + k, coords, 0);
+    }
+    locate_prepare();
+
+    // Inside the hull.
+    fix = locate_tag(1800, 1300);
+    CHECK(fix.flag);
+    CHECK_NEAR(fix.x, 1800, 3);
+    CHECK_NEAR(fix.y, 1300, 3);
+
+    // Outside the hull and the anchor bounding box.
+    fix = locate_tag(400, 2500);
+    CHECK(fix.flag);
+    CHECK_NEAR(fix.x, 400, 3);
+    CHECK_NEAR(fix.y, 2500, 3);
+
+    // Beyond the padded box: no fix rather than a clamped one.
+    fix = locate_tag(-3000, 1500);
+    CHECK(!fix.flag);
+
+    return test_result("test_grid");
+}
@@ -0,0 +1,77 @@
+/*
+ * Indoor Localization intersection list tests
+ *
+ * Checks that points merged by the spatial hash keep counting as candidates:
+ * their hits carry into get_polygon and weight get_centroid, so three anchors
+ * with exact ranges still give a three-point polygon.
+ */
+
+#include <localization.h>
+
+#include "test.h"
+
+#include <math.h>
+
+static struct Coordinates point(float x, float y)
+{
+    struct Coordinates coords = {.flag = true, .x = x, .y = y};
+    return coords;
+}
+
+static void test_merge_hits(void)
+{
+    struct IPs *ip;
+
+    remove_all_intersections(IPs_LIST1);
+    add_intersection(point(100, 100), IPs_LIST1);
+    add_intersection(point(101, 100), IPs_LIST1); // Within the tolerance, merged
+    add_intersection(point(100, 99), IPs_LIST1);
+    add_intersection(point(300, 100), IPs_LIST1);
+
+    CHECK(get_intersection_count(IPs_LIST1) == 2);
+    ip = get_intersections(IPs_LIST1);
+    CHECK(ip != NULL && ip->hits == 3);
+    CHECK(ip != NULL && ip->next != NULL && ip->next->hits == 1);
+
+    // Weighted by hits: (3 * 100 + 300) / 4.
+    CHECK_NEAR(get_centroid(IPs_LIST1).x, 150.0f, 0.01f);
+
+    merge_intersection(point(300, 101), 2, IPs_LIST1);
+    CHECK(get_intersection_count(IPs_LIST1) == 2);
+    CHECK(ip != NULL && ip->next != NULL && ip->next->hits == 3);
+    remove_all_intersections(IPs_LIST1);
+}
+
+/*
+With exact ranges the three pairwise intersections at the tag merge into one
+point. The polygon must still see three candidates and not fall back to the
+error_rate = 1 average over every intersection.
+*/
+static void test_three_anchors(void)
+{
+    static const float ax[3] = {0, 1000, 0};
+    static const float ay[3] = {0, 0, 1000};
+    struct Coordinates fix;
+    struct Anchor *anchor_ptr;
+    float tx = 300, ty = 400;
+    int k;
+
+    remove_all_anchors();
+    for (k = 0; k < 3; k++)
+        add_anchor(0x1000 + k, point(ax[k], ay[k]), 0);
+    locate_prepare();
+    for (anchor_ptr = front; anchor_ptr != NULL; anchor_ptr = anchor_ptr->next)
+        anchor_ptr->distance = hypotf(anchor_ptr->coords.x - tx, anchor_ptr->coords.y - ty);
+
+    fix = get_dev_location();
+    CHECK(fix.flag);
+    CHECK_NEAR(fix.x, tx, 2.0f);
+    CHECK_NEAR(fix.y, ty, 2.0f);
+}
+
+int main(void)
+{
+    test_merge_hits();
+    test_three_anchors();
+    return test_result("test_intersections");
+}
@@ -0,0 +1,154 @@
+/*
+ * Indoor Localization round ring tests
+ *
+ * Checks the ring on one thread (empty, full, order, index wrap) and then
+ * runs a producer and a consumer thread against each other, the consumer
+ * verifying every sample of every round. Build with
+ * -DLOCALIZATION_TEST_TSAN=ON to run the two-thread part under
+ * ThreadSanitizer.
+ */
+
+#include <round_ring.h>
+
+#include "test.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+
+#define STRESS_ROUNDS 200000
+#define STRESS_SAMPLES 64
+
+static struct Round_Ring ring;
+
+static void fill_round(struct Ranging_Round *round, uint32_t cycle)
+{
+    int i;
+
+    round->cycle = cycle;
+    round->timestamp = cycle * 3;
+    round->count = 1 + cycle % STRESS_SAMPLES;
+    for (i = 0; i < round->count; i++)
+    {
+        round->samples[i].anchor = (uint16_t)(cycle + i);
+        round->samples[i].dt = (uint16_t)(cycle * 7 + i);
+        round->samples[i].distance = (float)(cycle % 1000) + i;
+    }
+}
+
+static bool round_matches(const struct Ranging_Round *round, uint32_t cycle)
+{
+    int i;
+
+    if (round->cycle != cycle || round->timestamp != cycle * 3 || round->count != (int)(1 + cycle % STRESS_SAMPLES))
+        return false;
+    for (i = 0; i < round->count; i++)
+    {
+        if (round->samples[i].anchor != (uint16_t)(cycle + i) || round->samples[i].dt != (uint16_t)(cycle * 7 + i) ||
+            round->samples[i].distance != (float)(cycle % 1000) + i)
+            return false;
+    }
+    return true;
+}
+
+static void test_single_thread(void)
+{
+    struct Ranging_Round *round;
+    uint32_t cycle;
+    int i;
+
+    round_ring_reset(&ring);
+    CHECK(round_ring_peek(&ring) == NULL);
+
+    // Fills up after LOC_ROUND_RING rounds.
+    for (i = 0; i < LOC_ROUND_RING; i++)
+    {
+        round = round_ring_claim(&ring);
+        CHECK(round != NULL);
+        if (round == NULL)
+            return;
+        fill_round(round, i);
+        round_ring_publish(&ring);
+    }
+    CHECK(round_ring_claim(&ring) == NULL);
+
+    // Claiming again before publishing gives the same slot.
+    round_ring_release(&ring);
+    round = round_ring_claim(&ring);
+    CHECK(round != NULL && round == round_ring_claim(&ring));
+
+    // Rounds come out in order.
+    round = round_ring_peek(&ring);
+    CHECK(round != NULL && round_matches(round, 1));
+    CHECK(round_ring_peek(&ring) == round);
+
+    // Indices wrap at UINT_MAX.
+    atomic_store(&ring.head, UINT_MAX - 1);
+    atomic_store(&ring.tail, UINT_MAX - 1);
+    for (cycle = 0; cycle < 4 * LOC_ROUND_RING; cycle++)
+    {
+        round = round_ring_claim(&ring);
+        CHECK(round != NULL);
+        if (round == NULL)
+            return;
+        fill_round(round, cycle);
+        round_ring_publish(&ring);
+        round = round_ring_peek(&ring);
+        CHECK(round != NULL && round_matches(round, cycle));
+        round_ring_release(&ring);
+        CHECK(round_ring_peek(&ring) == NULL);
+    }
+}
+
+static void *producer(void *arg)
+{
+    struct Ranging_Round *round;
+    uint32_t cycle = 0;
+
+    while (cycle < STRESS_ROUNDS)
+    {
+        round = round_ring_claim(&ring);
+        if (round == NULL)
+        {
+            sched_yield();
+            continue;
+        }
+        fill_round(round, cycle++);
+        round_ring_publish(&ring);
+    }
+    return arg;
+}
+
+static void test_two_threads(void)
+{
+    struct Ranging_Round *round;
+    uint32_t cycle = 0;
+    unsigned long bad = 0;
+    pthread_t thread;
+
+    round_ring_reset(&ring);
+    CHECK(pthread_create(&thread, NULL, producer, NULL) == 0);
+    while (cycle < STRESS_ROUNDS)
+    {
+        round = round_ring_peek(&ring);
+        if (round == NULL)
+        {
+            sched_yield();
+            continue;
+        }
+        if (!round_matches(round, cycle))
+            bad++;
+        round_ring_release(&ring);
+        cycle++;
+    }
+    pthread_join(thread, NULL);
+    CHECK(bad == 0);
+    CHECK(round_ring_peek(&ring) == NULL);
+}
+
+int main(void)
+{
+    test_single_thread();
+    test_two_threads();
+    return test_result("test_round_ring");
+}
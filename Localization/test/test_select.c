@@ -0,0 +1,80 @@
+/*
+ * Indoor Localization anchor selection tests
+ *
+ * Checks that plan_record() keeps the misses of the ranged anchors, that
+ * ranging results fused by update_anchor_range() leave them alone, and that
+ * plan_ranging() starts from a healthy anchor.
+ */
+
+#include <localization.h>
+
+#include "test.h"
+
+static struct Ranging_Plan plan;
+
+static void add_anchors(void)
+{
+    static const float ax[4] = {0, 1000, 1000, 0};
+    static const float ay[4] = {0, 0, 1000, 1000};
+    struct Coordinates coords = {.flag = true};
+    int k;
+
+    remove_all_anchors();
+    for (k = 0; k < 4; k++)
+    {
+        coords.x = ax[k];
+        coords.y = ay[k];
+        add_anchor(0x1000 + k, coords, 0);
+    }
+}
+
+static void test_record(void)
+{
+    struct Range_Sample failed = {.anchor = 0, .status = false, .distance = 0};
+    int k;
+
+    add_anchors();
+    plan_ranging(&plan, last_fix, anchor_count, true);
+    CHECK(plan.count == 4);
+
+    // Only the first two entries were ranged, the first without a valid sample.
+    plan.valid[0] = 0;
+    plan.valid[1] = 3;
+    for (k = 0; k < 3; k++)
+        plan_record(&plan, 2);
+    CHECK(plan.anchor[0]->misses == 3);
+    CHECK(plan.anchor[1]->misses == 0);
+    CHECK(plan.anchor[2]->misses == 0);
+
+    // Fusing a failed range does not count a miss a second time.
+    update_anchor_range(plan.anchor[0], &failed, 1, 1.0f);
+    CHECK(plan.anchor[0]->distance == -1);
+    CHECK(plan.anchor[0]->misses == 3);
+
+    plan.valid[0] = 1;
+    plan_record(&plan, 1);
+    CHECK(plan.anchor[0]->misses == 0);
+}
+
+static void test_healthy_first(void)
+{
+    struct Coordinates fix = {.flag = true, .x = 100, .y = 100};
+
+    add_anchors();
+    plan_ranging(&plan, last_fix, anchor_count, true);
+    plan.valid[0] = 0; // Anchor nearest to fix failed
+    plan.valid[1] = plan.valid[2] = plan.valid[3] = 1;
+    plan_record(&plan, plan.count);
+
+    plan_ranging(&plan, fix, 3, false);
+    CHECK(!plan.full_scan);
+    CHECK(plan.count == 3);
+    CHECK(plan.anchor[0]->host_id != 0x1000);
+}
+
+int main(void)
+{
+    test_record();
+    test_healthy_first();
+    return test_result("test_select");
+}
@@ -0,0 +1,83 @@
+/*
+ * Indoor Localization trace tests
+ *
+ * Round-trips the anchor map record and checks that a map record whose
+ * length does not match its anchor count, such as one with 12 byte entries,
+ * is rejected.
+ */
+
+#include <localization.h>
+#include <trace.h>
+#include <wire.h>
+
+#include "test.h"
+
+static uint8_t buf[TRACE_MAP_SIZE(8) + 16];
+
+static void add_anchors(void)
+{
+    struct Coordinates coords = {.flag = true};
+    int k;
+
+    remove_all_anchors();
+    bottom_left_corner = (struct Coordinates){.flag = true, .x = 10, .y = 20};
+    top_right_corner = (struct Coordinates){.flag = true, .x = 900, .y = 800};
+    for (k = 0; k < 3; k++)
+    {
+        coords.x = 100.0f * k;
+        coords.y = 50.0f + k;
+        add_anchor(0x1000 + k, coords, 250.0f + k);
+    }
+}
+
+static void test_map_round_trip(void)
+{
+    struct Anchor *anchor_ptr;
+    float ratio = 0;
+    int len, k;
+
+    add_anchors();
+    len = trace_encode_map(buf, sizeof(buf), 1.25f);
+    CHECK(len == TRACE_MAP_SIZE(3));
+
+    remove_all_anchors();
+    CHECK(trace_load_map(buf, len, &ratio) == 3);
+    CHECK(ratio == 1.25f);
+    CHECK(bottom_left_corner.x == 10 && top_right_corner.y == 800);
+    for (anchor_ptr = front, k = 0; anchor_ptr != NULL; anchor_ptr = anchor_ptr->next, k++)
+    {
+        CHECK(anchor_ptr->host_id == (uint32_t)(0x1000 + k));
+        CHECK(anchor_ptr->coords.x == 100.0f * k);
+        CHECK(anchor_ptr->z == 250.0f + k);
+    }
+    CHECK(k == 3);
+}
+
+static void test_map_length(void)
+{
+    float ratio;
+    int len;
+
+    add_anchors();
+    len = trace_encode_map(buf, sizeof(buf), 1.0f);
+
+    // Three 12 byte entries: the record is 12 bytes short of its count.
+    wire_put_u16(buf + 2, (uint16_t)(len - 3 * 4));
+    CHECK(trace_load_map(buf, len - 3 * 4, &ratio) == -1);
+
+    // Trailing bytes after the last entry.
+    wire_put_u16(buf + 2, (uint16_t)(len + 4));
+    CHECK(trace_load_map(buf, len + 4, &ratio) == -1);
+
+    // Truncated buffer.
+    wire_put_u16(buf + 2, (uint16_t)len);
+    CHECK(trace_load_map(buf, len - 1, &ratio) == -1);
+    CHECK(trace_load_map(buf, len, &ratio) == 3);
+}
+
+int main(void)
+{
+    test_map_round_trip();
+    test_map_length();
+    return test_result("test_trace");
+}
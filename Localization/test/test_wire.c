@@ -0,0 +1,628 @@
+/*
+ * Indoor Localization anchor table tests
+ *
+ * Encodes anchor maps the way the master does, splitting them into frames,
+ * decodes the frames the way the mobile does and checks that both ends agree
+ * on the map id and on the anchors, calibrations and outline.
+ */
+
+#include <localization.h>
+#include <wire.h>
+
+#include "test.h"
+
+#include <string.h>
+
+#define MAX_FRAMES 16
+#define MOBILE_ID 0x0a0b0c0d
+
+static const float outline_x[] = {0, 2865, 2865, 1400, 1400, 0};
+static const float outline_y[] = {0, 0, 2865, 2865, 1500, 1500};
+#define OUTLINE_VERTICES 6
+
+static const struct Range_Calibration test_calib = {
+    .offset = -35.25f,
+    .scale = 1.0213f,
+    .rssi_slope = 0.55f,
+    .rssi_ref = -80,
+};
+
+struct Table
+{
+    int frames;
+    uint32_t map_id;
+    struct Wire_Frame frame[MAX_FRAMES];
+};
+
+static struct Table table;
+static struct Wire_Table received;
+
+static struct Coordinates anchor_coords(int i)
+{
+    struct Coordinates coords = {
+        .flag = true,
+        .x = 135.4f + 61.3f * i,
+        .y = 2730.6f - 47.9f * i,
+    };
+    return coords;
+}
+
+static float anchor_height(int i, bool heights)
+{
+    return heights ? 200.0f + 10 * (i % 3) : 0.0f;
+}
+
+static uint32_t anchor_id(int i)
+{
+    return 0x48d74100 + i;
+}
+
+static void next_frame(struct Table *t)
+{
+    t->frame[t->frames + 1] = t->frame[t->frames];
+    t->frames++;
+    wire_frame_next(&t->frame[t->frames]);
+}
+
+/*
+Same record order and splitting as send_anchor_table() of the master: a record
+that does not fit goes first in the next frame, the map id and the done marker
+travel together.
+*/
+static void encode_table(struct Table *t, uint8_t version, uint32_t host_id, int anchors, bool calib, bool heights)
+{
+    struct Wire_Frame *frame;
+    int i;
+
+    t->frames = 0;
+    frame = &t->frame[0];
+    wire_frame_begin(frame, host_id, version);
+    CHECK(wire_put_outline(frame, outline_x, outline_y, OUTLINE_VERTICES));
+    for (i = 0; i < anchors; i++)
+    {
+        if (!wire_put_anchor(&t->frame[t->frames], anchor_id(i), anchor_coords(i), anchor_height(i, heights)))
+        {
+            next_frame(t);
+            CHECK(wire_put_anchor(&t->frame[t->frames], anchor_id(i), anchor_coords(i), anchor_height(i, heights)));
+        }
+        if (calib && !wire_put_calib(&t->frame[t->frames], anchor_id(i), &test_calib))
+        {
+            next_frame(t);
+            CHECK(wire_put_calib(&t->frame[t->frames], anchor_id(i), &test_calib));
+        }
+    }
+    frame = &t->frame[t->frames];
+    if (frame->len + WIRE_MAP_ID_SIZE + WIRE_DONE_SIZE > WIRE_FRAME_SIZE)
+    {
+        next_frame(t);
+        frame = &t->frame[t->frames];
+    }
+    t->map_id = wire_table_hash(frame);
+    CHECK(wire_put_map_id(frame, t->map_id));
+    CHECK(wire_put_done(frame));
+    t->frames++;
+}
+
+static void clear_map(void)
+{
+    remove_all_anchors();
+    remove_all_calibrations();
+    remove_building();
+}
+
+static bool decode_table(const struct Table *t)
+{
+    int i;
+
+    clear_map();
+    wire_table_begin(&received);
+    for (i = 0; i < t->frames; i++)
+    {
+        if (wire_load_frame(t->frame[i].buf, t->frame[i].len, &received) < 0)
+            return false;
+    }
+    return true;
+}
+
+/*
+The decoded anchor queue holds every anchor in order, within tolerance of the
+encoded position (0 for float records, half a pixel for compact ones).
+*/
+static void check_anchors(int anchors, bool calib, bool heights, float tolerance)
+{
+    const struct Range_Calibration *c;
+    struct Anchor *anchor = front;
+    int i;
+
+    CHECK(anchor_count == anchors);
+    for (i = 0; i < anchors && anchor != NULL; i++, anchor = anchor->next)
+    {
+        CHECK(anchor->host_id == anchor_id(i));
+        CHECK_NEAR(anchor->coords.x, anchor_coords(i).x, tolerance);
+        CHECK_NEAR(anchor->coords.y, anchor_coords(i).y, tolerance);
+        CHECK_NEAR(anchor->z, anchor_height(i, heights), tolerance);
+    }
+    CHECK(calibration_count == (calib ? anchors : 0));
+    c = find_calibration(anchor_id(anchors - 1));
+    if (calib && c != NULL)
+    {
+        CHECK_NEAR(c->offset, test_calib.offset, tolerance > 0 ? 0.05f : 0);
+        CHECK_NEAR(c->scale, test_calib.scale, tolerance > 0 ? 0.00005f : 0);
+        CHECK_NEAR(c->rssi_slope, test_calib.rssi_slope, tolerance > 0 ? 0.005f : 0);
+        CHECK(c->rssi_ref == test_calib.rssi_ref);
+    }
+    CHECK(building.count == OUTLINE_VERTICES);
+}
+
+static void test_round_trip(uint8_t version, float tolerance)
+{
+    static const int sizes[] = {3, 7, 40};
+    unsigned i;
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        encode_table(&table, version, MOBILE_ID, sizes[i], true, true);
+        CHECK(decode_table(&table));
+        CHECK(wire_table_verified(&received));
+        CHECK(!wire_table_current(&received));
+        CHECK(received.map_id == table.map_id);
+        CHECK(received.hash == table.map_id);
+        check_anchors(sizes[i], true, true, tolerance);
+    }
+}
+
+/*
+40 float anchors with calibration take several frames; every frame but the
+last ends with a record that filled it, and the records are not cut.
+*/
+static void test_frame_split(void)
+{
+    int i;
+
+    encode_table(&table, WIRE_VERSION_FLOAT, MOBILE_ID, 40, true, false);
+    CHECK(table.frames > 2);
+    for (i = 0; i < table.frames; i++)
+    {
+        CHECK(table.frame[i].len <= WIRE_FRAME_SIZE);
+        CHECK(wire_get_u32(table.frame[i].buf) == MOBILE_ID);
+        CHECK(table.frame[i].buf[4] == ANCHOR_TABLE_PKT);
+        CHECK(table.frame[i].buf[5] == WIRE_VERSION_FLOAT);
+    }
+    for (i = 0; i + 1 < table.frames; i++)
+        CHECK(table.frame[i].len + WIRE_CALIB_SIZE > WIRE_FRAME_SIZE);
+
+    CHECK(decode_table(&table));
+    CHECK(wire_table_verified(&received));
+    check_anchors(40, true, false, 0);
+
+    // Only the last frame ends the table.
+    clear_map();
+    wire_table_begin(&received);
+    for (i = 0; i + 1 < table.frames; i++)
+    {
+        CHECK(wire_load_frame(table.frame[i].buf, table.frame[i].len, &received) > 0);
+        CHECK(!received.done);
+    }
+}
+
+/*
+The map id depends on the records only: the same map gives the same id for
+every mobile, and any change to the map changes it.
+*/
+static void test_map_id(void)
+{
+    uint32_t map_id;
+
+    encode_table(&table, WIRE_VERSION_FLOAT, MOBILE_ID, 7, true, false);
+    map_id = table.map_id;
+    encode_table(&table, WIRE_VERSION_FLOAT, 0x12345678, 7, true, false);
+    CHECK(table.map_id == map_id);
+    encode_table(&table, WIRE_VERSION_FLOAT, MOBILE_ID, 7, false, false);
+    CHECK(table.map_id != map_id);
+    encode_table(&table, WIRE_VERSION_FLOAT, MOBILE_ID, 8, true, false);
+    CHECK(table.map_id != map_id);
+
+    // FNV-1a reference values.
+    CHECK(wire_hash(WIRE_HASH_INIT, NULL, 0) == 0x811c9dc5u);
+    CHECK(wire_hash(WIRE_HASH_INIT, (const uint8_t *)"a", 1) == 0xe40c292cu);
+    CHECK(wire_hash(WIRE_HASH_INIT, (const uint8_t *)"foobar", 6) == 0xbf9cf968u);
+}
+
+static void test_corrupted_table(void)
+{
+    encode_table(&table, WIRE_VERSION_FLOAT, MOBILE_ID, 7, false, false);
+    table.frame[0].buf[WIRE_HEADER_SIZE + 5] ^= 0x01; // A bit of the first outline vertex
+    CHECK(decode_table(&table));
+    CHECK(received.done && received.has_map_id);
+    CHECK(!wire_table_verified(&received));
+    CHECK(!wire_table_current(&received));
+}
+
+/*
+The map id closes the table: a record after it is not covered by the id and
+stops the frame.
+*/
+static void test_record_after_map_id(void)
+{
+    static struct Wire_Frame frame;
+    struct Coordinates coords = anchor_coords(0);
+
+    wire_frame_begin(&frame, MOBILE_ID, WIRE_VERSION_FLOAT);
+    CHECK(wire_put_anchor(&frame, anchor_id(0), coords, 0));
+    CHECK(wire_put_map_id(&frame, wire_table_hash(&frame)));
+    CHECK(wire_put_anchor(&frame, anchor_id(1), coords, 0));
+    CHECK(wire_put_done(&frame));
+
+    clear_map();
+    wire_table_begin(&received);
+    CHECK(wire_load_frame(frame.buf, frame.len, &received) == -1);
+    CHECK(anchor_count == 1);
+    CHECK(!received.done);
+}
+
+/*
+A table of only the map id and the done marker is what the master sends when
+the mobile already has the map.
+*/
+static void test_table_current(void)
+{
+    static struct Wire_Frame frame;
+    uint8_t version;
+
+    for (version = WIRE_VERSION_FLOAT; version <= WIRE_VERSION_COMPACT; version++)
+    {
+        wire_frame_begin(&frame, MOBILE_ID, version);
+        CHECK(wire_put_map_id(&frame, 0xdeadbeef));
+        CHECK(wire_put_done(&frame));
+        CHECK(frame.len == WIRE_HEADER_SIZE + WIRE_MAP_ID_SIZE + WIRE_DONE_SIZE);
+
+        clear_map();
+        wire_table_begin(&received);
+        CHECK(wire_load_frame(frame.buf, frame.len, &received) == 2);
+        CHECK(wire_table_current(&received));
+        CHECK(!wire_table_verified(&received));
+        CHECK(received.map_id == 0xdeadbeef);
+        CHECK(received.len == 0);
+        CHECK(anchor_count == 0);
+
+        // The table is complete, a further frame is not part of it.
+        CHECK(wire_load_frame(frame.buf, frame.len, &received) == -1);
+    }
+
+    // No map id yet: neither current nor verified.
+    wire_frame_begin(&frame, MOBILE_ID, WIRE_VERSION_FLOAT);
+    CHECK(wire_put_done(&frame));
+    wire_table_begin(&received);
+    CHECK(wire_load_frame(frame.buf, frame.len, &received) == 1);
+    CHECK(received.done);
+    CHECK(!wire_table_current(&received));
+    CHECK(!wire_table_verified(&received));
+}
+
+/*
+The records a verified table keeps replay to the same map, which is how the
+mobile loads its map cache.
+*/
+static void test_cached_records(void)
+{
+    static uint8_t records[LOC_MAP_CACHE_SIZE];
+    uint8_t version;
+    int len;
+
+    encode_table(&table, WIRE_VERSION_FLOAT, MOBILE_ID, 7, true, true);
+    CHECK(decode_table(&table));
+    CHECK(wire_table_verified(&received));
+    CHECK(received.len > 0);
+    CHECK(wire_hash(WIRE_HASH_INIT, received.records, received.len) == table.map_id);
+
+    len = received.len;
+    version = received.version;
+    memcpy(records, received.records, len);
+    clear_map();
+    CHECK(wire_load_records(version, records, len) == 1 + 7 + 7);
+    check_anchors(7, true, true, 0);
+
+    // Too large for the cache: still decoded, just not kept.
+    encode_table(&table, WIRE_VERSION_FLOAT, MOBILE_ID, 40, true, false);
+    CHECK(decode_table(&table));
+    CHECK(wire_table_verified(&received));
+    CHECK(received.len == -1);
+    CHECK(anchor_count == 40);
+}
+
+/*
+Walks the compact records of a frame and counts the anchors of its anchor
+records, checking that every record header is whole.
+*/
+static int compact_frame_anchors(const struct Wire_Frame *frame, int *runs)
+{
+    const uint8_t *p = frame->buf + WIRE_HEADER_SIZE;
+    const uint8_t *end = frame->buf + frame->len;
+    int anchors = 0;
+
+    *runs = 0;
+    while (p < end)
+    {
+        switch (*p)
+        {
+        case WIRE_ANCHOR:
+            anchors += p[1];
+            (*runs)++;
+            p += WIRE_RUN_SIZE + p[1] * WIRE_COMPACT_ANCHOR_SIZE(p[2]);
+            break;
+        case WIRE_CALIB:
+            p += WIRE_COMPACT_CALIB_SIZE;
+            break;
+        case WIRE_OUTLINE:
+            p += WIRE_COMPACT_OUTLINE_SIZE(p[1]);
+            break;
+        case WIRE_MAP_ID:
+            p += WIRE_MAP_ID_SIZE;
+            break;
+        case WIRE_DONE:
+            p += WIRE_DONE_SIZE;
+            break;
+        default:
+            CHECK(false);
+            return -1;
+        }
+    }
+    CHECK(p == end);
+    return anchors;
+}
+
+/*
+Consecutive anchors with the same flags share one record: its count grows in
+place. A height, a calibration or the end of the frame starts a new one.
+*/
+static void test_compact_runs(void)
+{
+    static struct Wire_Frame frame;
+    int runs;
+
+    wire_frame_begin(&frame, MOBILE_ID, WIRE_VERSION_COMPACT);
+    CHECK(wire_put_anchor(&frame, anchor_id(0), anchor_coords(0), 0));
+    CHECK(wire_put_anchor(&frame, anchor_id(1), anchor_coords(1), 0));
+    CHECK(wire_put_anchor(&frame, anchor_id(2), anchor_coords(2), 0));
+    CHECK(frame.len == WIRE_HEADER_SIZE + WIRE_RUN_SIZE + 3 * WIRE_COMPACT_ANCHOR_SIZE(0));
+    CHECK(compact_frame_anchors(&frame, &runs) == 3 && runs == 1);
+
+    CHECK(wire_put_anchor(&frame, anchor_id(3), anchor_coords(3), 250));
+    CHECK(wire_put_anchor(&frame, anchor_id(4), anchor_coords(4), 0));
+    CHECK(wire_put_calib(&frame, anchor_id(4), &test_calib));
+    CHECK(wire_put_anchor(&frame, anchor_id(5), anchor_coords(5), 0));
+    CHECK(compact_frame_anchors(&frame, &runs) == 6 && runs == 4);
+
+    // A height that rounds to the floor needs no Z.
+    wire_frame_begin(&frame, MOBILE_ID, WIRE_VERSION_COMPACT);
+    CHECK(wire_put_anchor(&frame, anchor_id(0), anchor_coords(0), 0.4f));
+    CHECK(frame.buf[WIRE_HEADER_SIZE + 2] == 0);
+    CHECK(frame.len == WIRE_HEADER_SIZE + WIRE_RUN_SIZE + WIRE_COMPACT_ANCHOR_SIZE(0));
+}
+
+/*
+A run interrupted by the end of a frame restarts with its own header in the
+next frame, and both halves decode to the whole anchor list.
+*/
+static void test_compact_run_split(void)
+{
+    int anchors = 0;
+    int runs, i;
+
+    encode_table(&table, WIRE_VERSION_COMPACT, MOBILE_ID, 60, false, false);
+    CHECK(table.frames > 1);
+    for (i = 0; i < table.frames; i++)
+    {
+        anchors += compact_frame_anchors(&table.frame[i], &runs);
+        CHECK(runs == 1);
+        CHECK(table.frame[i].buf[5] == WIRE_VERSION_COMPACT);
+        if (i > 0)
+            CHECK(table.frame[i].buf[WIRE_HEADER_SIZE] == WIRE_ANCHOR);
+    }
+    CHECK(anchors == 60);
+    CHECK(table.frame[0].len + WIRE_COMPACT_ANCHOR_SIZE(0) > WIRE_FRAME_SIZE);
+
+    CHECK(decode_table(&table));
+    CHECK(wire_table_verified(&received));
+    check_anchors(60, false, false, 0.5f);
+}
+
+/*
+The encoder never sends an empty anchor record, but one is well formed and
+adds nothing.
+*/
+static void test_compact_empty_run(void)
+{
+    static struct Wire_Frame frame;
+    uint8_t *p;
+
+    wire_frame_begin(&frame, MOBILE_ID, WIRE_VERSION_COMPACT);
+    p = frame.buf + frame.len;
+    *p++ = WIRE_ANCHOR;
+    *p++ = 0;
+    *p++ = WIRE_ANCHOR_Z;
+    frame.len += WIRE_RUN_SIZE;
+    CHECK(wire_put_anchor(&frame, anchor_id(0), anchor_coords(0), 0));
+    CHECK(wire_put_done(&frame));
+
+    clear_map();
+    wire_table_begin(&received);
+    CHECK(wire_load_frame(frame.buf, frame.len, &received) == 3);
+    CHECK(anchor_count == 1);
+    CHECK(received.done);
+
+    // An empty record at the very end of a frame is not truncated either.
+    wire_frame_begin(&frame, MOBILE_ID, WIRE_VERSION_COMPACT);
+    frame.buf[frame.len++] = WIRE_ANCHOR;
+    frame.buf[frame.len++] = 0;
+    frame.buf[frame.len++] = 0;
+    wire_table_begin(&received);
+    CHECK(wire_load_frame(frame.buf, frame.len, &received) == 1);
+
+    // A count past the end of the frame is.
+    frame.buf[WIRE_HEADER_SIZE + 1] = 1;
+    wire_table_begin(&received);
+    CHECK(wire_load_frame(frame.buf, frame.len, &received) == -1);
+}
+
+/*
+Compact fields saturate at their int16 (int8 for the RSSI reference) range
+instead of wrapping.
+*/
+static void test_compact_clamping(void)
+{
+    static const struct Range_Calibration far = {
+        .offset = 5000.0f,
+        .scale = 9.0f,
+        .rssi_slope = -400.0f,
+        .rssi_ref = -200,
+    };
+    static const struct Range_Calibration near = {
+        .offset = -0.04f,
+        .scale = 1.0f,
+        .rssi_slope = 0.006f,
+        .rssi_ref = 127,
+    };
+    static struct Wire_Frame frame;
+    const struct Range_Calibration *c;
+    struct Coordinates coords = {.flag = true, .x = 40000.0f, .y = -40000.0f};
+
+    CHECK(wire_quantize(2.5f, 1.0f) == 3);
+    CHECK(wire_quantize(-2.5f, 1.0f) == -3);
+    CHECK(wire_quantize(1e9f, 1.0f) == INT16_MAX);
+    CHECK(wire_quantize(-1e9f, 1.0f) == INT16_MIN);
+    CHECK_NEAR(wire_dequantize(wire_quantize(-35.25f, WIRE_OFFSET_UNIT), WIRE_OFFSET_UNIT), -35.3f, 0.001f);
+
+    wire_frame_begin(&frame, MOBILE_ID, WIRE_VERSION_COMPACT);
+    CHECK(wire_put_anchor(&frame, anchor_id(0), coords, 50000.0f));
+    CHECK(wire_put_calib(&frame, anchor_id(0), &far));
+    CHECK(wire_put_calib(&frame, anchor_id(1), &near));
+    CHECK(wire_put_done(&frame));
+
+    clear_map();
+    wire_table_begin(&received);
+    CHECK(wire_load_frame(frame.buf, frame.len, &received) == 4);
+    CHECK(front != NULL);
+    if (front != NULL)
+    {
+        CHECK(front->coords.x == INT16_MAX);
+        CHECK(front->coords.y == INT16_MIN);
+        CHECK(front->z == INT16_MAX);
+    }
+    c = find_calibration(anchor_id(0));
+    CHECK(c != NULL);
+    if (c != NULL)
+    {
+        CHECK_NEAR(c->offset, INT16_MAX * WIRE_OFFSET_UNIT, 0.01f);
+        CHECK_NEAR(c->scale, 1 + INT16_MAX * WIRE_SCALE_UNIT, 0.0001f);
+        CHECK_NEAR(c->rssi_slope, INT16_MIN * WIRE_SLOPE_UNIT, 0.01f);
+        CHECK(c->rssi_ref == INT8_MIN);
+    }
+    c = find_calibration(anchor_id(1));
+    CHECK(c != NULL);
+    if (c != NULL)
+    {
+        CHECK(c->offset == 0.0f);
+        CHECK(c->scale == 1.0f);
+        CHECK_NEAR(c->rssi_slope, 0.01f, 0.0001f);
+        CHECK(c->rssi_ref == 127);
+    }
+}
+
+/*
+Only the two known versions decode, and all frames of a table share one.
+*/
+static void test_versions(void)
+{
+    static struct Wire_Frame frame;
+    static const uint8_t unknown[] = {0x00, 0x03, 0xff};
+    unsigned i;
+
+    for (i = 0; i < sizeof(unknown); i++)
+    {
+        wire_frame_begin(&frame, MOBILE_ID, unknown[i]);
+        CHECK(wire_put_map_id(&frame, 0xdeadbeef));
+        CHECK(wire_put_done(&frame));
+        wire_table_begin(&received);
+        CHECK(wire_load_frame(frame.buf, frame.len, &received) == -1);
+        CHECK(!received.done);
+        CHECK(wire_load_records(unknown[i], frame.buf + WIRE_HEADER_SIZE, 0) == 0);
+    }
+    CHECK(wire_load_records(0x03, table.frame[0].buf + WIRE_HEADER_SIZE, WIRE_OUTLINE_SIZE(OUTLINE_VERTICES)) == -1);
+
+    // The version of the first frame holds for the whole table.
+    encode_table(&table, WIRE_VERSION_FLOAT, MOBILE_ID, 40, false, false);
+    CHECK(table.frames > 1);
+    table.frame[1].buf[5] = WIRE_VERSION_COMPACT;
+    CHECK(!decode_table(&table));
+    CHECK(!received.done);
+
+    // Float records read as compact ones do not decode.
+    encode_table(&table, WIRE_VERSION_FLOAT, MOBILE_ID, 3, false, false);
+    table.frame[0].buf[5] = WIRE_VERSION_COMPACT;
+    CHECK(!decode_table(&table));
+}
+
+/*
+The compact table is about half the float one.
+*/
+static void test_compact_size(void)
+{
+    int float_bytes = 0;
+    int compact_bytes = 0;
+    int i;
+
+    encode_table(&table, WIRE_VERSION_FLOAT, MOBILE_ID, 40, false, false);
+    for (i = 0; i < table.frames; i++)
+        float_bytes += table.frame[i].len;
+    encode_table(&table, WIRE_VERSION_COMPACT, MOBILE_ID, 40, false, false);
+    for (i = 0; i < table.frames; i++)
+        compact_bytes += table.frame[i].len;
+    CHECK(2 * compact_bytes < float_bytes + 2 * WIRE_HEADER_SIZE * table.frames);
+}
+
+static void test_malformed_frames(void)
+{
+    static struct Wire_Frame frame;
+    struct Coordinates coords = anchor_coords(0);
+
+    wire_frame_begin(&frame, MOBILE_ID, WIRE_VERSION_FLOAT);
+    CHECK(wire_put_anchor(&frame, anchor_id(0), coords, 0));
+
+    // Truncated record.
+    wire_table_begin(&received);
+    CHECK(wire_load_frame(frame.buf, frame.len - 1, &received) == -1);
+
+    // Short header, other packet type.
+    wire_table_begin(&received);
+    CHECK(wire_load_frame(frame.buf, WIRE_HEADER_SIZE - 1, &received) == -1);
+    frame.buf[4] = 0x10;
+    wire_table_begin(&received);
+    CHECK(wire_load_frame(frame.buf, frame.len, &received) == -1);
+    frame.buf[4] = ANCHOR_TABLE_PKT;
+
+    // Unknown record type.
+    frame.buf[WIRE_HEADER_SIZE] = 0x7f;
+    wire_table_begin(&received);
+    CHECK(wire_load_frame(frame.buf, frame.len, &received) == -1);
+}
+
+int main(void)
+{
+    test_round_trip(WIRE_VERSION_FLOAT, 0);
+    test_round_trip(WIRE_VERSION_COMPACT, 0.5f);
+    test_frame_split();
+    test_map_id();
+    test_corrupted_table();
+    test_record_after_map_id();
+    test_table_current();
+    test_cached_records();
+    test_malformed_frames();
+    test_compact_runs();
+    test_compact_run_split();
+    test_compact_empty_run();
+    test_compact_clamping();
+    test_versions();
+    test_compact_size();
+    return test_result("test_wire");
+}
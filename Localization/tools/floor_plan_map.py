@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+# Generates the occupancy map of the floor plan used by the particle filter.
+#
+# Every cell of CELL x CELL map pixels that contains a dark pixel (a wall) is
+# marked occupied. The map is stored as one bit per cell, rows of bits packed
+# LSB first. Only the standard library is needed, so the PNG is decoded here.
+#
+# usage: floor_plan_map.py [-c cell] floor_plan.png include/floor_plan.h src/floor_plan.c
+
+import argparse
+import os
+import struct
+import zlib
+
+DARK = 128  # Gray level below which a pixel is a wall
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def load_png(path):
+    data = open(path, 'rb').read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError(path + ' is not a PNG file')
+
+    pos = 8
+    idat = b''
+    while pos < len(data):
+        length, = struct.unpack('>I', data[pos:pos + 4])
+        kind = data[pos + 4:pos + 8]
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b'IHDR':
+            width, height, depth, color, _, _, interlace = struct.unpack('>IIBBBBB', body)
+        elif kind == b'IDAT':
+            idat += body
+    if depth != 8 or interlace != 0 or color not in (0, 2, 4, 6):
+        raise ValueError('only 8 bit non-interlaced gray/RGB(A) images are supported')
+
+    bpp = {0: 1, 2: 3, 4: 2, 6: 4}[color]
+    stride = width * bpp
+    raw = zlib.decompress(idat)
+    rows = []
+    prev = bytearray(stride)
+    pos = 0
+    for _ in range(height):
+        kind = raw[pos]
+        line = bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        if kind == 1:
+            for i in range(bpp, stride):
+                line[i] = (line[i] + line[i - bpp]) & 0xFF
+        elif kind == 2:
+            for i in range(stride):
+                line[i] = (line[i] + prev[i]) & 0xFF
+        elif kind == 3:
+            for i in range(stride):
+                left = line[i - bpp] if i >= bpp else 0
+                line[i] = (line[i] + ((left + prev[i]) >> 1)) & 0xFF
+        elif kind == 4:
+            for i in range(stride):
+                left = line[i - bpp] if i >= bpp else 0
+                upper_left = prev[i - bpp] if i >= bpp else 0
+                line[i] = (line[i] + paeth(left, prev[i], upper_left)) & 0xFF
+        rows.append(line)
+        prev = line
+    return width, height, bpp, color, rows
+
+
+def wall_mask(line, bpp, color):
+    # 1 for every dark, opaque pixel of the row. The first channel stands for
+    # the gray level, the floor plan is black on white.
+    dark = bytes(1 if v < DARK else 0 for v in range(256))
+    mask = bytearray(line[0::bpp].translate(dark))
+    if color in (4, 6):
+        opaque = bytes(1 if v >= 128 else 0 for v in range(256))
+        alpha = line[bpp - 1::bpp].translate(opaque)
+        mask = bytearray(m & a for m, a in zip(mask, alpha))
+    return mask
+
+
+def build_map(path, cell):
+    width, height, bpp, color, rows = load_png(path)
+    columns = (width + cell - 1) // cell
+    cell_rows = (height + cell - 1) // cell
+    occupied = [[False] * columns for _ in range(cell_rows)]
+    for y, line in enumerate(rows):
+        mask = wall_mask(line, bpp, color)
+        row = occupied[y // cell]
+        for cx in range(columns):
+            if not row[cx] and 1 in mask[cx * cell:(cx + 1) * cell]:
+                row[cx] = True
+    return width, height, columns, cell_rows, occupied
+
+
+def pack(occupied, columns):
+    row_bytes = (columns + 7) // 8
+    cells = bytearray()
+    for row in occupied:
+        packed = bytearray(row_bytes)
+        for cx, wall in enumerate(row):
+            if wall:
+                packed[cx >> 3] |= 1 << (cx & 7)
+        cells += packed
+    return row_bytes, cells
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('-c', '--cell', type=int, default=16, help='cell size in map pixels')
+    parser.add_argument('png')
+    parser.add_argument('header')
+    parser.add_argument('source')
+    args = parser.parse_args()
+
+    width, height, columns, cell_rows, occupied = build_map(args.png, args.cell)
+    row_bytes, cells = pack(occupied, columns)
+    name = os.path.basename(args.png)
+
+    with open(args.header, 'w') as f:
+        f.write('/*\n'
+                ' * Indoor Localization floor plan\n'
+                ' *\n'
+                ' * Occupancy map of %s (%d x %d map pixels), generated\n'
+                ' * by tools/floor_plan_map.py. Do not edit. One bit per cell, set for walls,\n'
+                ' * rows packed LSB first.\n'
+                ' */\n\n'
+                '#ifndef LOCALIZATION_FLOOR_PLAN_H_\n'
+                '#define LOCALIZATION_FLOOR_PLAN_H_\n\n'
+                '#include <stdint.h>\n\n'
+                '#define FLOOR_PLAN_CELL_SIZE %d\n'
+                '#define FLOOR_PLAN_COLUMNS %d\n'
+                '#define FLOOR_PLAN_ROWS %d\n'
+                '#define FLOOR_PLAN_ROW_BYTES %d\n\n'
+                'extern const uint8_t floor_plan_cells[FLOOR_PLAN_ROWS * FLOOR_PLAN_ROW_BYTES];\n\n'
+                '#endif /* LOCALIZATION_FLOOR_PLAN_H_ */\n'
+                % (name, width, height, args.cell, columns, cell_rows, row_bytes))
+
+    with open(args.source, 'w') as f:
+        f.write('/*\n'
+                ' * Indoor Localization floor plan\n'
+                ' *\n'
+                ' * Generated by tools/floor_plan_map.py from %s. Do not edit.\n'
+                ' */\n\n'
+                '#include <floor_plan.h>\n\n'
+                'const uint8_t floor_plan_cells[FLOOR_PLAN_ROWS * FLOOR_PLAN_ROW_BYTES] = {\n' % name)
+        for row in range(cell_rows):
+            chunk = cells[row * row_bytes:(row + 1) * row_bytes]
+            f.write('    ' + ', '.join('0x%02x' % b for b in chunk) + ',\n')
+        f.write('};\n')
+
+
+if __name__ == '__main__':
+    main()
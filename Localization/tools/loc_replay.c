@@ -0,0 +1,294 @@
+/*
+ * Indoor Localization trace replay
+ *
+ * Feeds ranging traces recorded by the mobile (CONFIG_LOCALIZATION_TRACE)
+ * through the solver library. The input is either a captured serial log, where
+ * every record is a "TRC:<hex>" line, or a raw binary stream of records (-b).
+ * Replay is deterministic: the same capture always gives the same fixes.
+ *
+ * With -t the ranges also go through the Kalman tracker, the way the firmware
+ * runs with CONFIG_LOCALIZATION_TRACKER, and the tracked position is printed.
+ * -m picks the range estimator (mean, median, mad, trimmed). -H picks how the
+ * anchor heights are used and -T sets the tag height in map pixels.
+ *
+ * usage: loc_replay [-b] [-q] [-t] [-e solver] [-m estimator] [-H flat|projected|3d] [-T tag_height] [-R tier_threshold] [-l loops] capture
+ */
+
+#include <localization.h>
+#include <trace.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TRACE_TAG "TRC:"
+#define MAX_ROUND_SAMPLES (LOC_MAX_ANCHORS * LOC_MAX_SAMPLES)
+
+struct Replay
+{
+    float ratio;
+    bool map_loaded;
+    bool quiet;
+    bool track;
+    struct Anchor *anchors[LOC_MAX_ANCHORS];
+    unsigned long rounds;
+    unsigned long fixes;
+};
+
+static struct Range_Sample round_samples[MAX_ROUND_SAMPLES];
+
+static int hex_value(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+static void replay_map(struct Replay *replay, const uint8_t *buf, int len)
+{
+    struct Anchor *temp_anchor;
+    int i = 0;
+
+    if (trace_load_map(buf, len, &replay->ratio) < 0)
+    {
+        fprintf(stderr, "invalid map record\n");
+        return;
+    }
+    for (temp_anchor = front; temp_anchor != NULL; temp_anchor = temp_anchor->next)
+        replay->anchors[i++] = temp_anchor;
+    locate_prepare();
+    last_fix.flag = false;
+    tracker_reset(&tracker);
+#if LOC_SOLVER_PARTICLE
+    particle_reset();
+#endif
+    replay->map_loaded = true;
+}
+
+static void replay_round(struct Replay *replay, const uint8_t *buf, int len)
+{
+    struct Coordinates fix;
+    uint32_t cycle, timestamp;
+    int count, first, i;
+
+    count = trace_decode_round(buf, len, &cycle, &timestamp, round_samples, MAX_ROUND_SAMPLES);
+    if (count < 0 || !replay->map_loaded)
+    {
+        fprintf(stderr, "skipping round record (%s)\n", count < 0 ? "invalid" : "no map yet");
+        return;
+    }
+
+    // Anchors missing from the round were not ranged (anchor selection).
+    reset_anchor_ranges();
+
+    // Samples of one anchor are consecutive, reduce each run to a range.
+    for (first = 0; first < count; first = i)
+    {
+        for (i = first; i < count && round_samples[i].anchor == round_samples[first].anchor; i++)
+            ;
+        if (round_samples[first].anchor >= anchor_count)
+            continue;
+        update_anchor_range(replay->anchors[round_samples[first].anchor], &round_samples[first], i - first, replay->ratio);
+        if (replay->track)
+            tracker_range(&tracker, replay->anchors[round_samples[first].anchor], timestamp + round_samples[i - 1].dt);
+    }
+
+    fix = locate_device();
+    if (replay->track && count > 0)
+    {
+        tracker_round(&tracker, fix, timestamp + round_samples[count - 1].dt);
+        fix = tracker_position(&tracker, timestamp + round_samples[count - 1].dt);
+    }
+    replay->rounds++;
+    if (fix.flag)
+        replay->fixes++;
+    if (!replay->quiet)
+    {
+        if (fix.flag)
+            printf("%u %u %d %d\n", cycle, timestamp, (int)fix.x, (int)fix.y);
+        else
+            printf("%u %u - -\n", cycle, timestamp);
+    }
+}
+
+static void replay_record(struct Replay *replay, const uint8_t *buf, int len)
+{
+    if (buf[1] == TRACE_MAP)
+        replay_map(replay, buf, len);
+    else if (buf[1] == TRACE_CALIB)
+    {
+        if (trace_load_calib(buf, len) < 0)
+            fprintf(stderr, "skipping invalid calibration record\n");
+    }
+    else if (buf[1] == TRACE_BUILDING)
+    {
+        if (trace_load_building(buf, len) < 0)
+            fprintf(stderr, "skipping invalid building record\n");
+    }
+    else
+        replay_round(replay, buf, len);
+}
+
+static void replay_binary(struct Replay *replay, const uint8_t *data, long size)
+{
+    long offset = 0;
+    int length;
+
+    while (offset < size)
+    {
+        length = trace_record_length(data + offset, (int)(size - offset > 65535 ? 65535 : size - offset));
+        if (length <= 0)
+        {
+            offset++; // Resynchronize on the next magic byte.
+            continue;
+        }
+        replay_record(replay, data + offset, length);
+        offset += length;
+    }
+}
+
+static void replay_log(struct Replay *replay, const char *text, uint8_t *buf, int buf_size)
+{
+    const char *line = text;
+    const char *p;
+    int len, hi, lo;
+
+    while ((line = strstr(line, TRACE_TAG)) != NULL)
+    {
+        p = line + strlen(TRACE_TAG);
+        len = 0;
+        while (len < buf_size && (hi = hex_value(p[0])) >= 0 && (lo = hex_value(p[1])) >= 0)
+        {
+            buf[len++] = (uint8_t)((hi << 4) | lo);
+            p += 2;
+        }
+        if (trace_record_length(buf, len) == len)
+            replay_record(replay, buf, len);
+        else
+            fprintf(stderr, "skipping truncated record\n");
+        line = p;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    struct Replay replay = {.ratio = 1, .map_loaded = false, .quiet = false, .track = false};
+    static uint8_t record[65536];
+    struct timespec start, end;
+    bool binary = false;
+    int loops = 1;
+    char *data;
+    long size;
+    FILE *file;
+    double elapsed;
+    int opt, i;
+
+    while ((opt = getopt(argc, argv, "bqte:m:H:T:R:l:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'b':
+            binary = true;
+            break;
+        case 'q':
+            replay.quiet = true;
+            break;
+        case 't':
+            replay.track = true;
+            break;
+        case 'e':
+            if (find_solver(optarg) < 0)
+            {
+                fprintf(stderr, "unknown solver %s\n", optarg);
+                return 1;
+            }
+            solver_engine = (uint8_t)find_solver(optarg);
+            break;
+        case 'm':
+            if (find_estimator(optarg) < 0)
+            {
+                fprintf(stderr, "unknown estimator %s\n", optarg);
+                return 1;
+            }
+            range_estimator = (uint8_t)find_estimator(optarg);
+            break;
+        case 'H':
+            if (strcmp(optarg, "flat") == 0)
+                height_mode = HEIGHT_FLAT;
+            else if (strcmp(optarg, "projected") == 0)
+                height_mode = HEIGHT_PROJECTED;
+            else if (strcmp(optarg, "3d") == 0)
+                height_mode = HEIGHT_3D;
+            else
+            {
+                fprintf(stderr, "unknown height mode %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'T':
+            tag_height = strtof(optarg, NULL);
+            break;
+        case 'R':
+            tiered_solving = true;
+            tier_threshold = strtof(optarg, NULL);
+            break;
+        case 'l':
+            loops = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-b] [-q] [-t] [-e solver] [-m estimator] [-H flat|projected|3d] [-T tag_height] [-R tier_threshold] [-l loops] capture\n", argv[0]);
+            return 1;
+        }
+    }
+    if (optind >= argc || loops <= 0)
+    {
+        fprintf(stderr, "usage: %s [-b] [-q] [-t] [-e solver] [-m estimator] [-H flat|projected|3d] [-T tag_height] [-R tier_threshold] [-l loops] capture\n", argv[0]);
+        return 1;
+    }
+
+    file = fopen(argv[optind], "rb");
+    if (file == NULL)
+    {
+        perror(argv[optind]);
+        return 1;
+    }
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    data = malloc(size + 1);
+    if (data == NULL || fread(data, 1, size, file) != (size_t)size)
+    {
+        fprintf(stderr, "cannot read %s\n", argv[optind]);
+        fclose(file);
+        return 1;
+    }
+    data[size] = '\0';
+    fclose(file);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < loops; i++)
+    {
+        if (binary)
+            replay_binary(&replay, (const uint8_t *)data, size);
+        else
+            replay_log(&replay, data, record, sizeof(record));
+        replay.quiet = replay.quiet || loops > 1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+    fprintf(stderr, "%lu rounds, %lu fixes, %.3f s, %.0f rounds/s\n",
+            replay.rounds, replay.fixes, elapsed, elapsed > 0 ? replay.rounds / elapsed : 0.0);
+    if (tiered_solving)
+        fprintf(stderr, "tiers: %s %u, %s %u, %s %u\n", tier_names[FIX_TIER_MINMAX], tier_count[FIX_TIER_MINMAX],
+                tier_names[FIX_TIER_PREVIOUS], tier_count[FIX_TIER_PREVIOUS], tier_names[FIX_TIER_FULL],
+                tier_count[FIX_TIER_FULL]);
+    free(data);
+    return 0;
+}
@@ -976,7 +976,7 @@ void sx1280_SetRfFrequency(uint32_t rfFrequency)
 	uint8_t buf[3];
 	uint32_t freq = 0;
 
-	freq = (uint32_t)((double)rfFrequency / (double)FREQ_STEP);
+	freq = rfFrequency / FREQ_STEP;
 	buf[0] = (uint8_t)((freq >> 16) & 0xFF);
 	buf[1] = (uint8_t)((freq >> 8) & 0xFF);
 	buf[2] = (uint8_t)(freq & 0xFF);
@@ -1505,10 +1505,10 @@ uint32_t sx1280GetLoRaBandwidth(uint8_t bw)
 	return 0x0;
 }
 
-double sx1280_GetRangingDistance(uint8_t resultType, int32_t regVal, float adjust,
-				 uint8_t bandWidth) // returns distance in meters
+float sx1280_GetRangingDistance(uint8_t resultType, int32_t regVal, float adjust,
+				uint8_t bandWidth) // returns distance in meters
 {
-	double val = 0.0;
+	float val = 0.0f;
 	//LOG_INF("DIST_REGVAL : %x %x %x %x", ((regVal>>24u)&0xFFu), ((regVal>>16u)&0xFFu), ((regVal>>8u)&0xFFu), ((regVal)&0xFFu));
 	if (regVal >=
 	    0x800000) //raw reg value at low distance can goto 0x800000 which is negative, set distance to zero if this happens
@@ -1523,16 +1523,16 @@ double sx1280_GetRangingDistance(uint8_t resultType, int32_t regVal, float adjus
 		// Convert the ranging LSB to distance in meter. The theoretical conversion from register value to distance [m] is given by:
 		// distance [m] = ( complement2( register ) * 150 ) / ( 2^12 * bandwidth[MHz] ) ). The API provide BW in [Hz] so the implemented
 		// formula is complement2( register ) / bandwidth[Hz] * A, where A = 150 / (2^12 / 1e6) = 36621.09
-		val = (double)regVal / (double)sx1280GetLoRaBandwidth(bandWidth) * 36621.09375;
+		val = (float)regVal / (float)sx1280GetLoRaBandwidth(bandWidth) * 36621.09375f;
 		break;
 
 	case RANGING_RESULT_AVERAGED:
 	case RANGING_RESULT_DEBIASED:
 	case RANGING_RESULT_FILTERED:
-		val = (double)regVal * 20.0 / 100.0;
+		val = (float)regVal * 20.0f / 100.0f;
 		break;
 	default:
-		val = 0.0;
+		val = 0.0f;
 		break;
 	}
 
@@ -1627,7 +1627,7 @@ struct lora_ranging_params sx1280_transmit_ranging(const struct device *dev,
 
 		rangingResult = sx1280_GetRangingResultRegValue(RANGING_RESULT_RAW);
 		range_params.distance =
-			(sx1280_GetRangingDistance(RANGING_RESULT_RAW, rangingResult, 1.0000,
+			(sx1280_GetRangingDistance(RANGING_RESULT_RAW, rangingResult, 1.0f,
 						   config->bandwidth)) *
 			100;
 		range_params.RSSIReg = sx1280_ReadRegister(REG_RANGING_RSSI);
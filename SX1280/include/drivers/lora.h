@@ -87,7 +87,7 @@ struct lora_ranging_params {
 	bool status;
 	uint8_t RSSIReg;
 	int16_t RSSIVal;
-	double distance; // in centimeters
+	float distance; // in centimeters
 };
 
 /**